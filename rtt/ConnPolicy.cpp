@@ -78,7 +78,7 @@ namespace RTT
     }
 
     ConnPolicy::ConnPolicy(int type /* = DATA*/, int lock_policy /*= LOCK_FREE*/)
-        : type(type), init(false), lock_policy(lock_policy), pull(false), size(0), transport(0), data_size(0) {}
+        : type(type), init(false), lock_policy(lock_policy), pull(false), size(0), transport(0), data_size(0), shared(false), readers(0), batch_size(0) {}
 
     /** @cond */
     /** This is dead code. We use the boost::serialization now.
@@ -141,6 +141,27 @@ namespace RTT
             log(Error) <<"ConnPolicy: wrong property type of 'pull'."<<endlog();
             return false;
         }
+        b = bag.getProperty("shared");
+        if ( b.ready() )
+            result.shared = b.get();
+        else if ( bag.find("shared") ){
+            log(Error) <<"ConnPolicy: wrong property type of 'shared'."<<endlog();
+            return false;
+        }
+        i = bag.getProperty("readers");
+        if ( i.ready() )
+            result.readers = i.get();
+        else if ( bag.find("readers") ){
+            log(Error) <<"ConnPolicy: wrong property type of 'readers'."<<endlog();
+            return false;
+        }
+        i = bag.getProperty("batch_size");
+        if ( i.ready() )
+            result.batch_size = i.get();
+        else if ( bag.find("batch_size") ){
+            log(Error) <<"ConnPolicy: wrong property type of 'batch_size'."<<endlog();
+            return false;
+        }
 
         s = bag.getProperty("name_id");
         if ( s.ready() )
@@ -168,6 +189,9 @@ namespace RTT
         targetbag.ownProperty( new Property<int>("transport","The prefered transport. Set to zero if unsure.", cp.transport));
         targetbag.ownProperty( new Property<int>("data_size","A hint about the data size of a single data sample. Set to zero if unsure.", cp.transport));
         targetbag.ownProperty( new Property<string>("name_id","The name of the connection to be formed.",cp.name_id));
+        targetbag.ownProperty( new Property<bool>("shared","Share the data storage with the other shared connections of the output port", cp.shared));
+        targetbag.ownProperty( new Property<int>("readers","The maximum number of threads reading a data connection concurrently. Set to zero if unsure.", cp.readers));
+        targetbag.ownProperty( new Property<int>("batch_size","The maximum number of samples packed into one message by out-of-band transports. Set to zero if unsure.", cp.batch_size));
     }
     /** @endcond */
 
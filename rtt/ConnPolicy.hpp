@@ -86,6 +86,16 @@ namespace RTT {
      *       the name contains a port number or file descriptor to be opened.
      *       You only need to provide a name_id if you're using out-of-band transports
      *       without supervisor, for example, when using MQueues without Corba.
+     *  <li> if the connection is shared. All shared connections of one OutputPort
+     *       use a single data object or buffer, such that a write() stores the
+     *       sample only once, independent of the number of readers. Each reader
+     *       keeps its own read position in the shared storage. Shared connections
+     *       are always lock free and only apply to local (in-process) connections.
+     *       All shared connections of a port must use the same type and size.
+     *  <li> the number of threads which read a lock-free data connection concurrently.
+     *       If set, the reads are wait-free for up to that many readers.
+     *  <li> the maximum number of samples an out-of-band transport may pack into
+     *       one message. Only the mqueue transport uses this.
      * </ul>
      * @ingroup Ports
      */
@@ -180,6 +190,39 @@ namespace RTT {
          * work around name clashes or if the transport protocol documents to do so.
          */
         mutable std::string name_id;
+
+        /**
+         * If true, this connection shares its data storage with all other shared
+         * connections of the same OutputPort. A write() then only copies the
+         * sample once, and each connected InputPort reads it with its own
+         * read cursor. The lock_policy is ignored, shared storage is always
+         * lock free. Only local connections can be shared, other connections
+         * ignore this flag.
+         */
+        bool   shared;
+
+        /**
+         * The maximum number of threads which read this connection concurrently,
+         * for example when an InputPort is read by a component and by a script.
+         * If non-zero, a lock-free DATA connection uses a base::DataObjectWaitFree
+         * sized for this number of readers, of which reads never retry and writes
+         * never drop samples. If zero (the default), base::DataObjectLockFree is
+         * used, which is sized for two readers. Other connections ignore this value.
+         * More concurrent readers than this number is an error, upon which the
+         * excess reader does not read (see base::DataObjectWaitFree::Get()).
+         */
+        int    readers;
+
+        /**
+         * The maximum number of samples the sending side of an out-of-band
+         * connection packs into a single message. If larger than one, the
+         * mqueue transport sends from a thread of its own, which packs all
+         * samples that were written since its previous message, such that
+         * a burst of small samples costs one mq_send instead of one per
+         * sample. Zero or one (the default) sends each sample from the
+         * writing thread. Other transports ignore this value.
+         */
+        int    batch_size;
     };
 }
 
@@ -46,6 +46,11 @@
 #include "TaskContext.hpp"
 #include "internal/CatchConfig.hpp"
 #include "extras/SlaveActivity.hpp"
+#include "os/TimeService.hpp"
+#include "os/Thread.hpp"
+#include "os/threads.hpp"
+#include "os/CAS.hpp"
+#include "internal/ParallelLanes.hpp"
 
 #include <boost/bind.hpp>
 #include <boost/ref.hpp>
@@ -56,8 +61,6 @@
 #include <functional>
 #include <algorithm>
 
-#define ORONUM_EE_MQUEUE_SIZE 100
-
 namespace RTT
 {
     /**
@@ -71,12 +74,19 @@ namespace RTT
     using namespace detail;
     using namespace boost;
 
-    ExecutionEngine::ExecutionEngine( TaskCore* owner )
+    ExecutionEngine::ExecutionEngine( TaskCore* owner, unsigned int queue_size, bool growable_queues )
         : taskc(owner),
-          mqueue(new MWSRQueue<DisposableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
-          f_queue( new MWSRQueue<ExecutableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
-          mmaster(0)
+          mqueue(new MWSRQueue<DisposableInterface*>(queue_size, growable_queues) ),
+          f_queue( new MWSRQueue<ExecutableInterface*>(queue_size, growable_queues) ),
+          mmaster(0),
+          msg_coalescing(false),
+          msg_wakeup(0),
+          stats_enabled(false),
+          stats_overruns(0),
+          child_lanes(0)
     {
+        oro_atomic_set(&msg_suppressed, 0);
+        oro_atomic_set(&msg_waiters, 0);
     }
 
     ExecutionEngine::~ExecutionEngine()
@@ -90,6 +100,8 @@ namespace RTT
         }
         assert( children.empty() );
 
+        delete child_lanes;
+
         ExecutableInterface* foo;
         while ( f_queue->dequeue( foo ) )
             foo->unloaded();
@@ -116,6 +128,30 @@ namespace RTT
             children.erase(it);
     }
 
+    bool ExecutionEngine::setParallelChildren(unsigned int helpers, unsigned cpu_affinity) {
+        // refuse while processChildren() executes the children, ie from within a child.
+        os::MutexTryLock lock(child_lock);
+        if ( !lock.isSuccessful() )
+            return false;
+        delete child_lanes;
+        child_lanes = 0;
+        if ( helpers == 0 )
+            return true;
+        int scheduler = ORO_SCHED_OTHER;
+        int priority = os::LowestPriority;
+        if ( this->getActivity() && this->getActivity()->thread() ) {
+            scheduler = this->getActivity()->thread()->getScheduler();
+            priority = this->getActivity()->thread()->getPriority();
+        }
+        child_lanes = new internal::ParallelLanes( boost::bind(&ExecutionEngine::processChildLane, this, _1, helpers + 1),
+                                         scheduler, priority, std::vector<unsigned>(helpers, cpu_affinity), "ChildWorker" );
+        return true;
+    }
+
+    unsigned int ExecutionEngine::getParallelChildren() const {
+        return child_lanes ? child_lanes->getLanes() - 1 : 0;
+    }
+
     void ExecutionEngine::processFunctions()
     {
         // Execute all loaded Functions :
@@ -230,6 +266,8 @@ namespace RTT
         // msg_lock may not be held when entering this function !
         DisposableInterface* com(0);
         {
+            // messages queued from now on must wake us up again.
+            os::CAS(&msg_wakeup, 1, 0);
             while ( mqueue->dequeue(com) ) {
                 assert( com );
                 com->executeAndDispose();
@@ -259,8 +297,26 @@ namespace RTT
                 return false;
 
             bool result = mqueue->enqueue( c );
-            this->getActivity()->trigger();
-            msg_cond.broadcast(); // required for waitAndProcessMessages() (EE thread)
+            if ( !msg_coalescing ) {
+                this->getActivity()->trigger();
+                msg_cond.broadcast(); // required for waitAndProcessMessages() (EE thread)
+                return result;
+            }
+            // only the first message of a burst triggers the activity: the
+            // engine was woken up before and did not start processing its
+            // messages yet, it will process this one as well.
+            if ( os::CAS(&msg_wakeup, 0, 1) )
+                this->getActivity()->trigger();
+            else
+                oro_atomic_inc(&msg_suppressed);
+            // Waiting threads must re-check their predicate for each message,
+            // also when the engine itself is blocked. The CAS above is a full
+            // barrier, so a waiter which is not counted yet will see the
+            // message when it checks its predicate under msg_lock.
+            if ( oro_atomic_read(&msg_waiters) != 0 ) {
+                MutexLock locker( msg_lock );
+                msg_cond.broadcast();
+            }
             return result;
         }
         return false;
@@ -312,9 +368,12 @@ namespace RTT
             return;
         // only to be called from the thread not executing step().
         os::MutexLock lock(msg_lock);
+        // counted before checking pred(), such that process() signals us.
+        oro_atomic_inc(&msg_waiters);
         while (!pred()) { // the mutex guards that processMessages can not run between !pred and the wait().
             msg_cond.wait(msg_lock); // now processMessages may run.
         }
+        oro_atomic_dec(&msg_waiters);
     }
 
 
@@ -327,9 +386,19 @@ namespace RTT
                 // only to be called from the thread executing step().
                 // We must lock because the cond variable will unlock msg_lock.
                 os::MutexLock lock(msg_lock);
+                // counted before checking pred(), such that process() signals us.
+                oro_atomic_inc(&msg_waiters);
                 if (!pred()) {
-                    msg_cond.wait(msg_lock); // now processMessages may run.
+                    // A message queued after processMessages() emptied the
+                    // queue may have been announced before we wait. With
+                    // message coalescing, it is the only announcement, so
+                    // process it instead of waiting for the next one.
+                    os::CAS(&msg_wakeup, 1, 0);
+                    if ( mqueue->isEmpty() )
+                        msg_cond.wait(msg_lock); // now processMessages may run.
+                    oro_atomic_dec(&msg_waiters);
                 } else {
+                    oro_atomic_dec(&msg_waiters);
                     return; // do not process messages when pred() == true;
                 }
             }
@@ -345,9 +414,13 @@ namespace RTT
                 // only to be called from the thread executing step().
                 // We must lock because the cond variable will unlock msg_lock.
                 os::MutexLock lock(msg_lock);
+                // counted before checking pred(), such that process() signals us.
+                oro_atomic_inc(&msg_waiters);
                 if (!pred()) {
                     msg_cond.wait(msg_lock); // now processMessages may run.
+                    oro_atomic_dec(&msg_waiters);
                 } else {
+                    oro_atomic_dec(&msg_waiters);
                     return; // do not process messages when pred() == true;
                 }
             }
@@ -355,9 +428,59 @@ namespace RTT
     }
 
     void ExecutionEngine::step() {
+        if ( !stats_enabled ) {
+            processMessages();
+            processFunctions();
+            processChildren(); // aren't these ExecutableInterfaces ie functions ?
+            return;
+        }
+        os::TimeService* ts = os::TimeService::Instance();
+        nsecs start = ts->getNSecs();
         processMessages();
+        nsecs messages = ts->getNSecs();
         processFunctions();
-        processChildren(); // aren't these ExecutableInterfaces ie functions ?
+        nsecs functions = ts->getNSecs();
+        processChildren();
+        nsecs children = ts->getNSecs();
+        stats.phases[ExecutionStatistics::Messages].add( messages - start );
+        stats.phases[ExecutionStatistics::Functions].add( functions - messages );
+        stats.phases[ExecutionStatistics::UpdateHook].add( children - functions );
+        stats.phases[ExecutionStatistics::Cycle].add( children - start );
+    }
+
+    void ExecutionEngine::setStatisticsEnabled(bool enable) {
+        stats_enabled = enable;
+    }
+
+    bool ExecutionEngine::isStatisticsEnabled() const {
+        return stats_enabled;
+    }
+
+    ExecutionStatistics ExecutionEngine::getStatistics() const {
+        ExecutionStatistics result = stats;
+        if ( this->getActivity() && this->getActivity()->thread() )
+            result.overruns = this->getActivity()->thread()->getOverrunCount() - stats_overruns;
+        return result;
+    }
+
+    void ExecutionEngine::resetStatistics() {
+        stats.reset();
+        if ( this->getActivity() && this->getActivity()->thread() )
+            stats_overruns = this->getActivity()->thread()->getOverrunCount();
+    }
+
+    void ExecutionEngine::setMessageCoalescing(bool on) {
+        msg_coalescing = on;
+        // drop a wake-up flag left behind while coalescing was switched off.
+        os::CAS(&msg_wakeup, 1, 0);
+    }
+
+    bool ExecutionEngine::getMessageCoalescing() const {
+        return msg_coalescing;
+    }
+
+    unsigned int ExecutionEngine::getSuppressedWakeups() const {
+        return oro_atomic_read(&msg_suppressed);
     }
 
     void ExecutionEngine::processChildren() {
@@ -394,36 +517,49 @@ namespace RTT
         if ( !this->getActivity() || ! this->getActivity()->isRunning() ) return;
 
         // call all children as well.
-        for (std::vector<TaskCore*>::iterator it = children.begin(); it != children.end();++it) {
-            if ( (*it)->mTaskState == TaskCore::Running  && (*it)->mTargetState == TaskCore::Running  ){
-                TRY (
-                    (*it)->prepareUpdateHook();
-                    (*it)->updateHook();
-                ) CATCH(std::exception const& e,
-                    log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
-                    log(Error) << "  " << e.what() << endlog();
-                    (*it)->exception();
-               ) CATCH_ALL (
-                    log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
-                    (*it)->exception(); // calls stopHook,cleanupHook
-                )
-            }
-            if (  (*it)->mTaskState == TaskCore::RunTimeError ){
-                TRY (
-                    (*it)->errorHook();
-                ) CATCH(std::exception const& e,
-                    log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
-                    log(Error) << "  " << e.what() << endlog();
-                    (*it)->exception();
-               ) CATCH_ALL (
-                    log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
-                    (*it)->exception(); // calls stopHook,cleanupHook
-                )
-            }
+        os::MutexLock lock(child_lock);
+        if ( !child_lanes || children.size() < 2 ) {
+            processChildLane(0, 1);
+            return;
+        }
+        child_lanes->run();
+    }
+
+    void ExecutionEngine::processChildLane(unsigned int lane, unsigned int lanes) {
+        for (unsigned int i = lane; i < children.size(); i += lanes) {
+            processChild( children[i] );
             if ( !this->getActivity() || ! this->getActivity()->isRunning() ) return;
         }
     }
 
+    void ExecutionEngine::processChild(TaskCore* tc) {
+        if ( tc->mTaskState == TaskCore::Running  && tc->mTargetState == TaskCore::Running  ){
+            TRY (
+                tc->prepareUpdateHook();
+                tc->updateHook();
+            ) CATCH(std::exception const& e,
+                log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
+                log(Error) << "  " << e.what() << endlog();
+                tc->exception();
+           ) CATCH_ALL (
+                log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
+                tc->exception(); // calls stopHook,cleanupHook
+            )
+        }
+        if (  tc->mTaskState == TaskCore::RunTimeError ){
+            TRY (
+                tc->errorHook();
+            ) CATCH(std::exception const& e,
+                log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
+                log(Error) << "  " << e.what() << endlog();
+                tc->exception();
+           ) CATCH_ALL (
+                log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
+                tc->exception(); // calls stopHook,cleanupHook
+            )
+        }
+    }
+
     bool ExecutionEngine::breakLoop() {
         bool ok = true;
         if (taskc)
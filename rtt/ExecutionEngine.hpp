@@ -42,17 +42,26 @@
 #include "os/Mutex.hpp"
 #include "os/MutexLock.hpp"
 #include "os/Condition.hpp"
+#include "os/oro_arch.h"
 #include "base/RunnableInterface.hpp"
 #include "base/ActivityInterface.hpp"
 #include "base/DisposableInterface.hpp"
 #include "base/ExecutableInterface.hpp"
 #include "internal/List.hpp"
+#include "ExecutionStatistics.hpp"
 #include <vector>
 #include <boost/function.hpp>
 
 #include "rtt-config.h"
 #include "internal/rtt-internal-fwd.hpp"
 
+/**
+ * The default size of the message and function queues of an ExecutionEngine.
+ */
+#ifndef ORONUM_EE_MQUEUE_SIZE
+#define ORONUM_EE_MQUEUE_SIZE 100
+#endif
+
 namespace RTT
 {
 
@@ -83,8 +92,13 @@ namespace RTT
          * and StateMachineProcessor.
          * @param owner The base::TaskCore in which this execution engine executes.
          * It may be null, in that case no base::TaskCore owns this execution engine.
+         * @param queue_size The number of messages and functions which
+         * can be queued for execution.
+         * @param growable_queues If true, full queues grow with segments of a
+         * preallocated pool, which is shared by all execution engines,
+         * instead of refusing messages and functions.
          */
-        ExecutionEngine( base::TaskCore* owner = 0);
+        ExecutionEngine( base::TaskCore* owner = 0, unsigned int queue_size = ORONUM_EE_MQUEUE_SIZE, bool growable_queues = false );
 
         ~ExecutionEngine();
 
@@ -199,6 +213,80 @@ namespace RTT
          */
         virtual void setActivity( base::ActivityInterface* task );
 
+        /**
+         * Enable or disable measuring the duration of each phase of step().
+         * Measuring is disabled by default, since it reads the clock
+         * four times per cycle.
+         */
+        void setStatisticsEnabled(bool enable);
+
+        /**
+         * Returns true if the duration of each phase of step() is measured.
+         */
+        bool isStatisticsEnabled() const;
+
+        /**
+         * Returns a copy of the measurements since the last resetStatistics(),
+         * and the number of overruns of the thread running this engine.
+         * When called from another thread than the thread of this engine,
+         * the measurements of one phase may be inconsistent with each other.
+         */
+        ExecutionStatistics getStatistics() const;
+
+        /**
+         * Clears all measurements.
+         */
+        void resetStatistics();
+
+        /**
+         * Execute the updateHook() of the children in parallel.
+         * The children are divided over \a helpers threads and the thread of
+         * this engine, and step() only returns when all of them are done, so
+         * the children remain synchronous with the cycle of this engine.
+         * The updateHook() of the owner is still executed before the children.
+         *
+         * Only use this for children which do not share data with each other,
+         * and which do not wait for operations of other components in
+         * their updateHook().
+         *
+         * @param helpers The number of helper threads, zero to execute
+         * the children one after the other in the thread of this engine.
+         * @param cpu_affinity The cpu affinity of the helper threads.
+         * The scheduler and priority are taken from the current activity.
+         * @return false if called while the children are executed,
+         * for example from the updateHook() of a child.
+         */
+        bool setParallelChildren(unsigned int helpers, unsigned cpu_affinity = ~0);
+
+        /**
+         * Returns the number of helper threads set with setParallelChildren().
+         */
+        unsigned int getParallelChildren() const;
+
+        /**
+         * Only wake up this engine for the first of a series of messages.
+         * When set, process() only triggers the activity when the queue
+         * was emptied since the previous wake-up, since processMessages()
+         * executes all queued messages at once. This saves context switches
+         * when many operation calls arrive in a burst. Threads waiting in
+         * waitForMessages() are still woken up for every message.
+         * The default is off.
+         * @param on true to coalesce wake-ups, false to wake up the engine
+         * for every message.
+         */
+        void setMessageCoalescing(bool on);
+
+        /**
+         * Returns true if process() coalesces wake-ups.
+         */
+        bool getMessageCoalescing() const;
+
+        /**
+         * Returns the number of wake-ups process() left out because the
+         * engine was already woken up for an earlier message.
+         */
+        unsigned int getSuppressedWakeups() const;
+
     protected:
         /**
          * Call this if you wish to block on a message arriving in the Execution Engine.
@@ -269,10 +357,52 @@ namespace RTT
          */
         ExecutionEngine *mmaster;
 
+        /**
+         * Message coalescing: msg_wakeup is 1 from the wake-up in process()
+         * until processMessages() starts emptying the queue.
+         */
+        bool msg_coalescing;
+        volatile int msg_wakeup;
+        oro_atomic_t msg_suppressed;
+
+        /**
+         * The number of threads waiting on msg_cond. With message coalescing,
+         * process() only signals msg_cond when it is not zero.
+         */
+        oro_atomic_t msg_waiters;
+
+        /**
+         * The measurements of step(), updated when stats_enabled is set.
+         */
+        ExecutionStatistics stats;
+        bool stats_enabled;
+        /**
+         * The overrun count of the thread at the last resetStatistics().
+         */
+        unsigned int stats_overruns;
+
+        /**
+         * Executes the lanes of the children in parallel, or null
+         * if they are executed in the thread of this engine.
+         * Guarded by child_lock, which is held while the children execute.
+         */
+        internal::ParallelLanes* child_lanes;
+        os::Mutex child_lock;
+
         void processMessages();
         void processFunctions();
         void processChildren();
 
+        /**
+         * Executes the hooks of \a tc for one cycle.
+         */
+        void processChild(base::TaskCore* tc);
+
+        /**
+         * Executes the children with index \a lane, \a lane + \a lanes, ...
+         */
+        void processChildLane(unsigned int lane, unsigned int lanes);
+
         virtual bool initialize();
 
         /**
@@ -0,0 +1,105 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ExecutionStatistics.cpp
+
+                        ExecutionStatistics.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ExecutionStatistics.hpp"
+
+namespace RTT
+{
+    void PhaseStatistics::reset()
+    {
+        count = 0;
+        min = max = total = 0;
+        for (unsigned int i = 0; i != HISTOGRAM_SIZE; ++i)
+            histogram[i] = 0;
+    }
+
+    void PhaseStatistics::add(nsecs duration)
+    {
+        if ( count == 0 || duration < min )
+            min = duration;
+        if ( count == 0 || duration > max )
+            max = duration;
+        total += duration;
+        ++count;
+
+        unsigned int bin = 0;
+        for (nsecs us = duration / 1000; us != 0 && bin != HISTOGRAM_SIZE - 1; us >>= 1)
+            ++bin;
+        ++histogram[bin];
+    }
+
+    void ExecutionStatistics::reset()
+    {
+        for (unsigned int i = 0; i != PhaseCount; ++i)
+            phases[i].reset();
+        overruns = 0;
+    }
+
+    const char* ExecutionStatistics::getPhaseName(Phase phase)
+    {
+        switch (phase) {
+        case Messages:
+            return "messages";
+        case Functions:
+            return "functions";
+        case UpdateHook:
+            return "updateHook";
+        case Cycle:
+            return "cycle";
+        default:
+            return "unknown";
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ExecutionStatistics& stats)
+    {
+        for (unsigned int i = 0; i != ExecutionStatistics::PhaseCount; ++i) {
+            const PhaseStatistics& p = stats.phases[i];
+            os << ExecutionStatistics::getPhaseName( ExecutionStatistics::Phase(i) )
+               << ": count " << p.count
+               << ", min " << p.min / 1000.0
+               << " us, mean " << p.mean() / 1000.0
+               << " us, max " << p.max / 1000.0
+               << " us, histogram [";
+            for (unsigned int b = 0; b != PhaseStatistics::HISTOGRAM_SIZE; ++b)
+                os << (b ? " " : "") << p.histogram[b];
+            os << "]" << std::endl;
+        }
+        os << "overruns: " << stats.overruns << std::endl;
+        return os;
+    }
+}
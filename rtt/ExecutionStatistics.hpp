@@ -0,0 +1,134 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ExecutionStatistics.hpp
+
+                        ExecutionStatistics.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_EXECUTION_STATISTICS_HPP
+#define ORO_EXECUTION_STATISTICS_HPP
+
+#include "rtt-config.h"
+#include "os/Time.hpp"
+#include <ostream>
+
+namespace RTT
+{
+    /**
+     * Timing statistics of one phase of an ExecutionEngine cycle.
+     * It does not allocate memory, hence it may be updated
+     * from a real-time thread.
+     */
+    struct RTT_API PhaseStatistics
+    {
+        /**
+         * The number of bins of the histogram. Bin 0 counts
+         * the durations below 1 microsecond, bin i the durations
+         * from 2^(i-1) up to 2^i microseconds and the last bin all
+         * longer durations.
+         */
+        static const unsigned int HISTOGRAM_SIZE = 16;
+
+        /**
+         * The number of measured durations.
+         */
+        unsigned long count;
+        /**
+         * The shortest, longest and summed durations, in nanoseconds.
+         */
+        nsecs min, max, total;
+        unsigned long histogram[HISTOGRAM_SIZE];
+
+        PhaseStatistics() { reset(); }
+
+        /**
+         * Clears all measurements.
+         */
+        void reset();
+
+        /**
+         * Adds one measured duration.
+         * @param duration The duration in nanoseconds.
+         */
+        void add(nsecs duration);
+
+        /**
+         * The mean duration in nanoseconds, or zero if nothing
+         * was measured.
+         */
+        nsecs mean() const { return count ? total / nsecs(count) : 0; }
+    };
+
+    /**
+     * Timing statistics of the cycles of an ExecutionEngine,
+     * for each phase of ExecutionEngine::step().
+     * @see ExecutionEngine::setStatisticsEnabled()
+     */
+    struct RTT_API ExecutionStatistics
+    {
+        enum Phase {
+            Messages,   //!< processMessages()
+            Functions,  //!< processFunctions()
+            UpdateHook, //!< processChildren(), the updateHook() of the owner and the children
+            Cycle,      //!< The complete step()
+            PhaseCount
+        };
+
+        PhaseStatistics phases[PhaseCount];
+
+        /**
+         * The number of periodic overruns of the thread
+         * running the ExecutionEngine.
+         */
+        unsigned int overruns;
+
+        ExecutionStatistics() : overruns(0) {}
+
+        /**
+         * Clears all measurements.
+         */
+        void reset();
+
+        /**
+         * Returns the name of \a phase.
+         */
+        static const char* getPhaseName(Phase phase);
+    };
+
+    /**
+     * Writes one line per phase, with the durations in microseconds.
+     */
+    RTT_API std::ostream& operator<<(std::ostream& os, const ExecutionStatistics& stats);
+}
+
+#endif
@@ -44,6 +44,7 @@
 #include "internal/InputPortSource.hpp"
 #include "Service.hpp"
 #include "OperationCaller.hpp"
+#include <boost/scoped_ptr.hpp>
 
 #include "OutputPort.hpp"
 
@@ -84,6 +85,42 @@ namespace RTT
             return false;
         }
 
+        bool do_read_all(std::vector<T>& samples, FlowStatus& result, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            if ( input ) {
+                FlowStatus tresult = input->readAll(samples);
+                if (tresult > result)
+                    result = tresult;
+            }
+            return false;
+        }
+
+        bool do_take(T const*& sample, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            assert( result != NewData );
+            if ( input ) {
+                T const* tsample = 0;
+                FlowStatus tresult = input->take(tsample, *take_sample, copy_old_data);
+                if (tresult == NewData) {
+                    sample = tsample;
+                    result = tresult;
+                    return true;
+                }
+                // like do_read(), only the current channel returns its old data.
+                if (tresult > result) {
+                    result = tresult;
+                    if (copy_old_data)
+                        sample = tsample;
+                }
+            }
+            return false;
+        }
+
+        /// The sample which take() reads into if a connection can not return it in place.
+        boost::scoped_ptr<T> take_sample;
+
         /**
          * You are not allowed to copy ports.
          * In case you want to create a container of ports,
@@ -161,6 +198,54 @@ namespace RTT
         }
 
 
+        /** Reads all new samples of all connections of this port in one pass.
+         * \a samples is cleared first and the new samples are appended to it,
+         * such that its capacity is reused. The samples of one connection are
+         * in order, but the samples of different connections are not merged
+         * in the order they were written.
+         *
+         * Returns RTT::NewData if at least one new sample was available, and
+         * either RTT::OldData or RTT::NoData otherwise.
+         */
+        FlowStatus readAll(std::vector<T>& samples)
+        {
+            samples.clear();
+            FlowStatus result = NoData;
+#ifdef USE_CPP11
+            cmanager.delete_if( bind( &InputPort::do_read_all, this, boost::ref(samples), boost::ref(result), _1) );
+#else
+            cmanager.delete_if( boost::bind( &InputPort::do_read_all, this, boost::ref(samples), boost::ref(result), boost::lambda::_1) );
+#endif
+            return result;
+        }
+
+        /** Reads a sample from the connection without copying it, if the
+         * connection allows so. This is the case for shared connections, of which
+         * the sample is returned in place. For the other connections, the sample
+         * is copied into a sample owned by this port, which is allocated by the
+         * first call to take().
+         *
+         * @param sample Is set to the sample read, unless RTT::NoData is returned.
+         * It remains valid until the next read() or take() on this port, or until
+         * the connection is removed.
+         * @see ConnPolicy::shared
+         */
+        FlowStatus take(T const*& sample)
+        {
+            if (!take_sample)
+            {
+                take_sample.reset( new T() );
+                getDataSample( *take_sample );
+            }
+            FlowStatus result = NoData;
+#ifdef USE_CPP11
+            cmanager.select_reader_channel( bind( &InputPort::do_take, this, boost::ref(sample), boost::ref(result), _1, _2), true );
+#else
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_take, this, boost::ref(sample), boost::ref(result), boost::lambda::_1, boost::lambda::_2), true );
+#endif
+            return result;
+        }
+
         /** Read all new samples that are available on this port, and returns
          * the last one.
          *
@@ -187,7 +272,7 @@ namespace RTT
          */
         void getDataSample(T& sample)
         {
-            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( cmanager.getCurrentChannel() );
+            typename base::ChannelElement<T>::shared_ptr input = boost::static_pointer_cast< base::ChannelElement<T> >( cmanager.getCurrentChannel() );
             if ( input ) {
                 sample = input->data_sample();
             }
@@ -81,7 +81,7 @@ namespace RTT
          * @post The resulting operation will have ClientThread execution semantics.
          */
         Operation(const std::string& name)
-        :OperationBase(name)
+        :OperationBase(name), mmax_pending(0)
         {
             // set null implementation such that we can already add it to the interface and register signals.
             ExecutionEngine* null_e = 0;
@@ -96,7 +96,7 @@ namespace RTT
          * @param ownerEngine the execution engine of the owner of this operation if any. Will be automatically set when you use Service::addOperation().
          */
         Operation(const std::string& name, boost::function<Signature> func, ExecutionThread et = ClientThread, ExecutionEngine* ownerEngine = NULL )
-        :OperationBase(name)
+        :OperationBase(name), mmax_pending(0)
         {
             this->calls(func, et, ownerEngine);
         }
@@ -111,7 +111,7 @@ namespace RTT
          */
         template<class Function, class Object>
         Operation(const std::string& name, Function func, Object o, ExecutionThread et = ClientThread, ExecutionEngine* ownerEngine = NULL )
-        :OperationBase(name)
+        :OperationBase(name), mmax_pending(0)
         {
             this->calls(func, o, et, ownerEngine);
         }
@@ -136,6 +136,29 @@ namespace RTT
          */
         Operation<Signature>& arg(const std::string& name, const std::string& description) { marg(name, description); return *this; }
 
+        /**
+         * Preallocates room for \a n asynchronous calls of this operation,
+         * which are shared by all OperationCaller objects that are set up
+         * from this operation afterwards. A send() then no longer allocates
+         * memory and returns a SendHandle with SendFailure status
+         * when \a n calls are pending. Use zero to allocate each call
+         * with the real-time allocator, which is the default.
+         * @note Call this before callers are created, for example
+         * right after adding the operation to a Service.
+         * @return A reference to this object.
+         */
+        Operation<Signature>& setMaxPendingCalls(unsigned int n) {
+            mmax_pending = n;
+            if (impl)
+                impl->setMaxPendingCalls(n);
+            return *this;
+        }
+
+        /**
+         * Returns the number of calls set with setMaxPendingCalls().
+         */
+        unsigned int getMaxPendingCalls() const { return mmax_pending; }
+
         /**
          * Indicate that this operation calls a given function.
          * This will replace any previously registered function present in this operation.
@@ -148,6 +171,8 @@ namespace RTT
             // creates a Local OperationCaller
             ExecutionEngine* null_caller = 0;
             impl = boost::make_shared<internal::LocalOperationCaller<Signature> >(func, ownerEngine ? ownerEngine : this->mowner, null_caller, et);
+            if (mmax_pending)
+                impl->setMaxPendingCalls(mmax_pending);
 #ifdef ORO_SIGNALLING_OPERATIONS
             if (signal)
                 impl->setSignal(signal);
@@ -169,6 +194,8 @@ namespace RTT
             // creates a Local OperationCaller or sets function
             ExecutionEngine* null_caller = 0;
             impl = boost::make_shared<internal::LocalOperationCaller<Signature> >(func, o, ownerEngine ? ownerEngine : this->mowner, null_caller, et);
+            if (mmax_pending)
+                impl->setMaxPendingCalls(mmax_pending);
 #ifdef ORO_SIGNALLING_OPERATIONS
             if (signal)
                 impl->setSignal(signal);
@@ -240,6 +267,7 @@ namespace RTT
 #endif
     private:
         typename internal::LocalOperationCaller<Signature>::shared_ptr impl;
+        unsigned int mmax_pending;
         virtual void ownerUpdated() {
             if (impl)
                 impl->setOwner( this->mowner );
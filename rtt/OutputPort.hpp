@@ -46,6 +46,7 @@
 #include "internal/ConnFactory.hpp"
 #include "Service.hpp"
 #include "OperationCaller.hpp"
+#include <boost/scoped_ptr.hpp>
 
 #include "InputPort.hpp"
 
@@ -71,10 +72,16 @@ namespace RTT
     {
         friend class internal::ConnInputEndpoint<T>;
 
-        bool do_write(typename base::ChannelElement<T>::param_t sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        bool do_write(typename base::ChannelElement<T>::param_t sample, bool& shared_written, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
             typename base::ChannelElement<T>::shared_ptr output
                 = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+            // shared connections store the sample only once, the others only need to be signalled.
+            if (descriptor.get<2>().shared) {
+                if (shared_written)
+                    return !output->signal();
+                shared_written = true;
+            }
             if (output->write(sample))
                 return false;
             else
@@ -84,6 +91,46 @@ namespace RTT
             }
         }
 
+        bool do_write_batch(std::vector<T> const& samples, bool& shared_written, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr output
+                = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+            if (descriptor.get<2>().shared) {
+                if (shared_written)
+                    return !output->signal();
+                shared_written = true;
+            }
+            if (output->writeBatch(samples))
+                return false;
+            else
+            {
+                log(Error) << "A channel of port " << getName() << " has been invalidated during writeBatch(), it will be removed" << endlog();
+                return true;
+            }
+        }
+
+        bool do_loan(const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            // only the shared connections can loan, as they store the sample only once.
+            if (!loaned && descriptor.get<2>().shared) {
+                typename base::ChannelElement<T>::shared_ptr output
+                    = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+                loaned = output->loan(loan_owner);
+            }
+            return false;
+        }
+
+        void keepWrittenValue(const T& sample)
+        {
+            if (keeps_last_written_value || keeps_next_written_value)
+            {
+                keeps_next_written_value = false;
+                has_initial_sample = true;
+                this->sample->Set(sample);
+            }
+            has_last_written_value = keeps_last_written_value;
+        }
+
         bool do_init(typename base::ChannelElement<T>::param_t sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
             typename base::ChannelElement<T>::shared_ptr output
@@ -109,7 +156,8 @@ namespace RTT
             {
                 T const& initial_sample = sample->Get();
                 if ( channel_el_input->data_sample(initial_sample) ) {
-                    if ( has_last_written_value && policy.init )
+                    // shared connections are initialized from the shared storage
+                    if ( has_last_written_value && policy.init && !policy.shared )
                         return channel_el_input->write(initial_sample);
                     return true;
                 } else {
@@ -135,6 +183,12 @@ namespace RTT
         // This is used to allow the use of the 'init' connection policy option
         bool keeps_last_written_value;
         typename base::DataObjectInterface<T>::shared_ptr sample;
+        /// The sample returned by loan(), until it is published.
+        T* loaned;
+        /// The channel element which owns \c loaned, if any.
+        typename base::ChannelElement<T>::shared_ptr loan_owner;
+        /// The sample loaned if no connection can loan one.
+        boost::scoped_ptr<T> loan_sample;
 
         /**
          * You are not allowed to copy ports.
@@ -169,6 +223,7 @@ namespace RTT
             , keeps_next_written_value(false)
             , keeps_last_written_value(false)
             , sample( new base::DataObject<T>() )
+            , loaned(0)
         {
             if (keep_last_written_value)
                 keepLastWrittenValue(true);
@@ -250,23 +305,107 @@ namespace RTT
          */
         void write(const T& sample)
         {
-            if (keeps_last_written_value || keeps_next_written_value)
+            keepWrittenValue(sample);
+
+            bool shared_written = false;
+#ifdef USE_CPP11
+            cmanager.delete_if( bind(
+                        &OutputPort<T>::do_write, this, boost::ref(sample), boost::ref(shared_written), _1)
+                    );
+#else
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_write, this, boost::ref(sample), boost::ref(shared_written), boost::lambda::_1)
+                    );
+#endif
+        }
+
+        /**
+         * Writes a sequence of samples to all receivers (if any), in order.
+         * Buffered connections store all samples in one pass and signal
+         * their reader only once, data connections only store the last sample.
+         * @param samples The new samples to send out.
+         */
+        void writeBatch(std::vector<T> const& samples)
+        {
+            if (samples.empty())
+                return;
+            keepWrittenValue(samples.back());
+
+            bool shared_written = false;
+#ifdef USE_CPP11
+            cmanager.delete_if( bind(
+                        &OutputPort<T>::do_write_batch, this, boost::cref(samples), boost::ref(shared_written), _1)
+                    );
+#else
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_write_batch, this, boost::cref(samples), boost::ref(shared_written), boost::lambda::_1)
+                    );
+#endif
+        }
+
+        /**
+         * Returns a sample to fill in and to write with publish(), such that
+         * large samples need not be copied. If this port has shared
+         * connections, the sample is loaned from their storage and is
+         * not copied by publish(). Otherwise, a sample owned by this port
+         * is returned, which is allocated by the first call to loan().
+         * Calling loan() again before publish() returns the same sample.
+         *
+         * The sample contains an older sample or the data sample
+         * of this port and must be completely filled in.
+         * @see ConnPolicy::shared
+         */
+        T& loan()
+        {
+            if (!loaned)
             {
-                keeps_next_written_value = false;
-                has_initial_sample = true;
-                this->sample->Set(sample);
+#ifdef USE_CPP11
+                cmanager.delete_if( bind( &OutputPort<T>::do_loan, this, _1) );
+#else
+                cmanager.delete_if( boost::bind( &OutputPort<T>::do_loan, this, boost::lambda::_1) );
+#endif
             }
-            has_last_written_value = keeps_last_written_value;
+            if (!loaned)
+            {
+                if (!loan_sample)
+                    loan_sample.reset( new T( sample->Get() ) );
+                loaned = loan_sample.get();
+            }
+            return *loaned;
+        }
 
+        /**
+         * Writes the sample returned by loan() to all receivers (if any).
+         * The shared connections receive the sample without copying it,
+         * the other connections copy it like write() does. It is also
+         * copied if this port keeps its last written value.
+         * Does nothing if no sample was loaned.
+         */
+        void publish()
+        {
+            T* published = loaned;
+            if (!published)
+                return;
+            loaned = 0;
+            keepWrittenValue(*published);
+
+            // the shared connections only need to be signalled when the loan was published.
+            bool shared_written = false;
+            if (loan_owner)
+            {
+                loan_owner->publish();
+                shared_written = true;
+            }
 #ifdef USE_CPP11
             cmanager.delete_if( bind(
-                        &OutputPort<T>::do_write, this, boost::ref(sample), _1)
+                        &OutputPort<T>::do_write, this, boost::cref(*published), boost::ref(shared_written), _1)
                     );
 #else
             cmanager.delete_if( boost::bind(
-                        &OutputPort<T>::do_write, this, boost::ref(sample), boost::lambda::_1)
+                        &OutputPort<T>::do_write, this, boost::cref(*published), boost::ref(shared_written), boost::lambda::_1)
                     );
 #endif
+            loan_owner.reset();
         }
 
         void write(base::DataSourceBase::shared_ptr source)
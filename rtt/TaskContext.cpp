@@ -42,6 +42,7 @@
 #include "plugin/PluginLoader.hpp"
 
 #include <string>
+#include <sstream>
 #include <algorithm>
 #include <functional>
 #include <boost/bind.hpp>
@@ -80,6 +81,19 @@ namespace RTT
         this->setup();
     }
 
+    TaskContext::TaskContext(const std::string& name, TaskState initial_state, unsigned int queue_size, bool growable_queues /*= false*/)
+        :  TaskCore( initial_state, queue_size, growable_queues )
+           ,portqueue( new MWSRQueue<PortInterface*>(queue_size, growable_queues) )
+           ,tcservice(new Service(name,this) ), tcrequests( new ServiceRequester(name,this) )
+#if defined(ORO_ACT_DEFAULT_SEQUENTIAL)
+           ,our_act( new SequentialActivity( this->engine() ) )
+#elif defined(ORO_ACT_DEFAULT_ACTIVITY)
+           ,our_act( new Activity( this->engine(), name ) )
+#endif
+    {
+        this->setup();
+    }
+
     TaskContext::TaskContext(const std::string& name, ExecutionEngine* parent, TaskState initial_state /*= Stopped*/ )
         :  TaskCore(parent, initial_state)
            ,portqueue( new MWSRQueue<PortInterface*>(64) )
@@ -118,6 +132,9 @@ namespace RTT
 
         this->addOperation("trigger", &TaskContext::trigger, this, ClientThread).doc("Trigger the update method for execution in the thread of this task.\n Only succeeds if the task isRunning() and allowed by the Activity executing this task.");
         this->addOperation("loadService", &TaskContext::loadService, this, ClientThread).doc("Loads a service known to RTT into this component.").arg("service_name","The name with which the service is registered by in the PluginLoader.");
+        this->addOperation("setExecutionStatisticsEnabled", &TaskContext::setExecutionStatisticsEnabled, this, ClientThread).doc("Enable or disable measuring the duration of each execution cycle.").arg("enable", "True to enable measuring.");
+        this->addOperation("getExecutionStatistics", &TaskContext::getExecutionStatistics, this, ClientThread).doc("Get the measured durations of each phase of the execution cycle and the number of periodic overruns.");
+        this->addOperation("resetExecutionStatistics", &TaskContext::resetExecutionStatistics, this, ClientThread).doc("Clear the measured durations and periodic overruns.");
         // activity runs from the start.
         if (our_act)
             our_act->start();
@@ -423,6 +440,23 @@ namespace RTT
         return false;
     }
 
+    void TaskContext::setExecutionStatisticsEnabled(bool enable)
+    {
+        engine()->setStatisticsEnabled(enable);
+    }
+
+    std::string TaskContext::getExecutionStatistics() const
+    {
+        std::stringstream result;
+        result << engine()->getStatistics();
+        return result.str();
+    }
+
+    void TaskContext::resetExecutionStatistics()
+    {
+        engine()->resetStatistics();
+    }
+
     void TaskContext::dataOnPort(PortInterface* port)
     {
         if ( this->dataOnPortHook(port) ) {
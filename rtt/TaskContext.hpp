@@ -109,6 +109,21 @@ namespace RTT
          */
         TaskContext( const std::string& name, TaskState initial_state = Stopped );
 
+        /**
+         * Create a TaskContext of which the message, function and
+         * port event queues hold \a queue_size elements. Use this
+         * constructor for components which receive bursts of operation
+         * calls or port events, which would otherwise be refused.
+         * @param name The name of this component.
+         * @param initial_state Provide the \a PreOperational parameter flag here
+         * to force users in calling configure(), before they call start().
+         * @param queue_size The size of the queues.
+         * @param growable_queues If true, the queues grow when they are full,
+         * using a preallocated pool shared by all components. Growing is
+         * real-time safe and only fails when the pool is exhausted.
+         */
+        TaskContext( const std::string& name, TaskState initial_state, unsigned int queue_size, bool growable_queues = false );
+
         /**
          * Create a TaskContext.
          * Its commands programs and state machines are processed by \a parent.
@@ -192,6 +207,25 @@ namespace RTT
         virtual bool start();
         virtual bool stop();
 
+        /**
+         * Enable or disable measuring the duration of each cycle
+         * of the ExecutionEngine of this TaskContext.
+         * @see ExecutionEngine::setStatisticsEnabled()
+         */
+        void setExecutionStatisticsEnabled(bool enable);
+
+        /**
+         * Returns the measured cycle durations and periodic overruns
+         * of the ExecutionEngine of this TaskContext, in a human readable form.
+         * Use engine()->getStatistics() to get the numbers.
+         */
+        std::string getExecutionStatistics() const;
+
+        /**
+         * Clears the measured cycle durations and periodic overruns.
+         */
+        void resetExecutionStatistics();
+
         /**
          * These functions are used to setup and manage peer-to-peer networks
          * of TaskContext objects.
@@ -53,4 +53,6 @@
 #include "BufferLockFree.hpp"
 #include "DataObject.hpp"
 #include "DataObjectLockFree.hpp"
+#include "DataObjectWaitFree.hpp"
+#include "DataObjectSeqLock.hpp"
 #include "DataObjectLocked.hpp"
@@ -43,6 +43,7 @@
 #include <boost/call_traits.hpp>
 #include "ChannelElementBase.hpp"
 #include "../FlowStatus.hpp"
+#include <vector>
 
 namespace RTT { namespace base {
 
@@ -121,6 +122,80 @@ namespace RTT { namespace base {
             else
                 return NoData;
         }
+
+        /** Writes a sequence of samples on this connection, in order.
+         * Connections which store more than one sample override this to
+         * store all samples in one pass.
+         *
+         * @returns false if an error occured that requires the channel to be invalidated.
+         */
+        virtual bool writeBatch(std::vector<value_t> const& samples)
+        {
+            for (typename std::vector<value_t>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+                if ( !this->write(*it) )
+                    return false;
+            return true;
+        }
+
+        /** Reads all new samples of this connection and appends them to
+         * \a samples, without clearing it. Connections which store more
+         * than one sample override this to read all samples in one pass.
+         *
+         * @returns NewData if at least one sample was appended. Otherwise
+         * returns OldData or NoData, like read() does.
+         */
+        virtual FlowStatus readAll(std::vector<value_t>& samples)
+        {
+            FlowStatus result = NoData, tresult;
+            value_t sample = value_t();
+            while ( (tresult = this->read(sample, false)) == NewData ) {
+                result = NewData;
+                samples.push_back(sample);
+            }
+            return result == NewData ? result : tresult;
+        }
+
+        /** Loans a sample from the data storage of this connection, such
+         * that it can be filled in and written by publish() without copying it.
+         * The loaned sample contains an older sample, or the data sample.
+         *
+         * @param owner Is set to the channel element that owns the loaned
+         * sample. It must be kept until publish() is called on it.
+         * @returns null if this connection can not loan samples.
+         */
+        virtual value_t* loan(shared_ptr& owner)
+        {
+            typename ChannelElement<T>::shared_ptr output = this->getOutput();
+            if (output)
+                return output->loan(owner);
+            return 0;
+        }
+
+        /** Writes the sample returned by loan() of this channel element.
+         *
+         * @returns false if the sample could not be stored.
+         */
+        virtual bool publish()
+        {
+            return false;
+        }
+
+        /** Reads a sample from the connection without copying it if the data
+         * storage of this connection allows so. Otherwise, the sample is
+         * read into \a buffer.
+         *
+         * @param sample Is set to the sample read, if any. It remains valid
+         * until the next read() or take() on this connection.
+         * @param buffer The storage to read into if the sample can not be
+         * returned in place.
+         */
+        virtual FlowStatus take(value_t const*& sample, reference_t buffer, bool copy_old_data)
+        {
+            FlowStatus result = this->read(buffer, copy_old_data);
+            if (result != NoData)
+                sample = &buffer;
+            return result;
+        }
     };
 }}
 
@@ -51,6 +51,8 @@
 #else
 #include "DataObjectLocked.hpp"
 #include "DataObjectLockFree.hpp"
+#include "DataObjectWaitFree.hpp"
+#include "DataObjectSeqLock.hpp"
 #endif
 
 namespace RTT
@@ -101,6 +101,9 @@ namespace RTT
          * must be declared volatile, since they are modified in other threads.
          * I did not declare data as volatile,
          * since we only read/write it in secured buffers.
+         * The buffers are a cache line apart, such that a reader
+         * which increments the counter of one buffer does not
+         * invalidate the buffer which is being written.
          */
         struct DataBuf {
             DataBuf()
@@ -109,13 +112,20 @@ namespace RTT
                 oro_atomic_set(&counter, 0);
             }
             DataType data; mutable oro_atomic_t counter; DataBuf* next;
+            char pad[ORO_CACHE_LINE_SIZE];
         };
 
         typedef DataBuf* volatile VolPtrType;
         typedef DataBuf  ValueType;
         typedef DataBuf* PtrType;
 
+        /**
+         * read_ptr is read by all readers, write_ptr only
+         * by the writer, hence they are padded into different cache lines.
+         */
+        char pad_before[ORO_CACHE_LINE_SIZE];
         VolPtrType read_ptr;
+        char pad_between[ORO_CACHE_LINE_SIZE];
         VolPtrType write_ptr;
 
         /**
@@ -0,0 +1,171 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  DataObjectSeqLock.hpp
+
+                        DataObjectSeqLock.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef CORELIB_DATAOBJECT_SEQ_LOCK_HPP
+#define CORELIB_DATAOBJECT_SEQ_LOCK_HPP
+
+
+#include "../os/oro_arch.h"
+#include "../os/CAS.hpp"
+#include "DataObjectInterface.hpp"
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * @brief A DataObject for plain old data types which stores
+     * a single sample, protected by a sequence lock.
+     *
+     * The sample is stored twice. A writer makes the sequence number
+     * odd and copies the sample into the first copy, then makes the
+     * sequence number even and copies it into the second copy. A reader
+     * copies the copy which is not being written, the second one while
+     * the sequence number is odd and the first one while it is even, and
+     * retries if the sequence number changed during its copy.
+     * Reads never write to shared memory, hence they do not bounce
+     * cache lines between readers, and no buffer management is required
+     * at the writer side.
+     *
+     * A reader only retries when a writer finished half a write during
+     * its copy, so a reader which preempted a writer on the same CPU
+     * reads the other copy instead of spinning on the preempted write.
+     * Neither a reader nor a writer ever blocks on a mutex.
+     *
+     * Because a reader may copy a sample which is being written, this
+     * DataObject may only be used for types which can be copied
+     * bytewise, such as scalars and structs of scalars
+     * (boost::is_pod<T>). Keep T small, such that the copy takes only
+     * a few nanoseconds.
+     *
+     * Concurrent writers are serialized by a flag, on which a writer
+     * spins while another writer writes. Do not let writers of the same
+     * DataObjectSeqLock preempt each other on one CPU.
+     * @ingroup PortBuffers
+     */
+    template<class T>
+    class DataObjectSeqLock
+        : public DataObjectInterface<T>
+    {
+    public:
+        /**
+         * The type of the data.
+         */
+        typedef T DataType;
+
+    private:
+        /**
+         * Odd while the first copy is written, even otherwise. The
+         * sequence number and the samples are padded, such that they do
+         * not share a cache line with other objects.
+         */
+        char pad_before[ORO_CACHE_LINE_SIZE];
+        int volatile seq;
+
+        /**
+         * Set while a writer writes.
+         */
+        int volatile writing;
+        DataType data[2];
+        char pad_after[ORO_CACHE_LINE_SIZE];
+
+        DataObjectSeqLock( DataObjectSeqLock const& );
+        DataObjectSeqLock& operator=( DataObjectSeqLock const& );
+    public:
+        /**
+         * Construct a DataObjectSeqLock.
+         *
+         * @param initial_value The initial value of this DataObject.
+         */
+        DataObjectSeqLock( const T& initial_value = T() )
+            : seq(0), writing(0)
+        {
+            data[0] = initial_value;
+            data[1] = initial_value;
+        }
+
+        /**
+         * Get a copy of the data.
+         *
+         * @return A copy of the data.
+         */
+        virtual DataType Get() const {DataType cache; Get(cache); return cache; }
+
+        /**
+         * Get a copy of the Data. Retries until no
+         * write completed a copy during the read.
+         *
+         * @param pull A copy of the data.
+         */
+        virtual void Get( DataType& pull ) const
+        {
+            int start;
+            do {
+                start = seq;
+                oro_rmb();
+                pull = data[ start & 1 ];
+                oro_rmb();
+            } while ( start != seq );
+        }
+
+        /**
+         * Set the data to a certain value (non blocking
+         * when there is only one writer).
+         *
+         * @param push The data which must be set.
+         */
+        virtual void Set( const DataType& push )
+        {
+            // serialize writers, this is a full barrier.
+            while ( !os::CAS(&writing, 0, 1) )
+                ;
+            int start = seq;
+            // readers move to the second copy.
+            os::CAS(&seq, start, start + 1);
+            data[0] = push;
+            // readers move back to the first copy.
+            os::CAS(&seq, start + 1, start + 2);
+            data[1] = push;
+            os::CAS(&writing, 1, 0);
+        }
+
+        virtual void data_sample( const DataType& sample ) {
+            Set(sample);
+        }
+    };
+}}
+
+#endif
@@ -0,0 +1,219 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  DataObjectWaitFree.hpp
+
+                        DataObjectWaitFree.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef CORELIB_DATAOBJECT_WAIT_FREE_HPP
+#define CORELIB_DATAOBJECT_WAIT_FREE_HPP
+
+
+#include "../os/oro_arch.h"
+#include "../os/CAS.hpp"
+#include "../Logger.hpp"
+#include "DataObjectInterface.hpp"
+#include <cassert>
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * @brief A DataObject of which both Get() and Set() are wait-free,
+     * for a given maximum number of concurrent readers.
+     *
+     * Unlike DataObjectLockFree, a reader never needs to retry because
+     * the writer published a new sample in the meantime. Each reader
+     * claims one of \a max_readers slots in which it announces the
+     * buffer it reads. When a reader announced that it is about to read,
+     * but did not read yet which buffer holds the newest sample, the
+     * writer fills it in for the reader after each Set(). The writer
+     * never writes into a buffer that is announced in a slot, hence
+     * max_readers + 2 buffers are enough to never drop a sample.
+     *
+     * More than \a max_readers concurrent readers is an error: an excess
+     * reader asserts in debug builds, and otherwise logs an error and
+     * returns without reading. Only one thread may Set() at a time.
+     * @ingroup PortBuffers
+     */
+    template<class T>
+    class DataObjectWaitFree
+        : public DataObjectInterface<T>
+    {
+    public:
+        /**
+         * The type of the data.
+         */
+        typedef T DataType;
+
+        /**
+         * @brief The maximum number of concurrent readers.
+         */
+        const unsigned int MAX_READERS;
+    private:
+        /**
+         * Conversion of number of readers to size of buffer.
+         */
+        const unsigned int BUF_LEN; // = MAX_READERS+2
+
+        /** The slot is not used by a reader. */
+        static const int FREE = -1;
+        /** The reader of the slot did not read the newest buffer yet. */
+        static const int REQUEST = -2;
+
+        struct DataBuf {
+            DataType data;
+        };
+
+        DataBuf* data;
+        /** One per reader, holding FREE, REQUEST or the buffer being read. */
+        int volatile* slots;
+        /** The buffer holding the newest sample. */
+        int volatile latest;
+
+        /**
+         * Claims a free slot, which is guaranteed to succeed in
+         * one pass if there are not more than MAX_READERS readers.
+         * @return MAX_READERS if all slots are in use.
+         */
+        unsigned int claimSlot() const {
+            for (unsigned int i = 0; i != MAX_READERS; ++i)
+                if ( slots[i] == FREE && os::CAS(&slots[i], FREE, REQUEST) )
+                    return i;
+            return MAX_READERS;
+        }
+
+        /**
+         * Returns true if \a buf is neither the newest buffer
+         * nor read by a reader.
+         */
+        bool isFree(int buf) const {
+            if ( buf == latest )
+                return false;
+            for (unsigned int i = 0; i != MAX_READERS; ++i)
+                if ( slots[i] == buf )
+                    return false;
+            return true;
+        }
+
+        DataObjectWaitFree( DataObjectWaitFree const& );
+        DataObjectWaitFree& operator=( DataObjectWaitFree const& );
+    public:
+        /**
+         * Construct a DataObjectWaitFree.
+         *
+         * @param initial_value The initial value of this DataObject.
+         * @param max_readers The maximum number of threads which
+         * may Get() concurrently without waiting.
+         */
+        DataObjectWaitFree( const T& initial_value = T(), unsigned int max_readers = 2 )
+            : MAX_READERS( max_readers ? max_readers : 1 ), BUF_LEN( MAX_READERS + 2 ),
+              data(0), slots(0), latest(0)
+        {
+            data = new DataBuf[BUF_LEN];
+            slots = new int volatile[MAX_READERS];
+            for (unsigned int i = 0; i != MAX_READERS; ++i)
+                slots[i] = FREE;
+            data_sample(initial_value);
+        }
+
+        ~DataObjectWaitFree() {
+            delete[] slots;
+            delete[] data;
+        }
+
+        /**
+         * Get a copy of the data.
+         * This method will allocate memory twice if data is not a value type.
+         * Use Get(DataType&) for the non-allocating version.
+         *
+         * @return A copy of the data.
+         */
+        virtual DataType Get() const {DataType cache; Get(cache); return cache; }
+
+        /**
+         * Get a copy of the Data (non allocating).
+         * If pull has reserved enough memory to store the copy,
+         * no memory will be allocated.
+         *
+         * @param pull A copy of the data, which is left unchanged
+         * if more than MAX_READERS threads read concurrently.
+         */
+        virtual void Get( DataType& pull ) const
+        {
+            unsigned int slot = claimSlot();
+            if ( slot == MAX_READERS ) {
+                assert( false && "more concurrent readers than ConnPolicy::readers" );
+                RTT::log(Error) << "DataObjectWaitFree: more than " << MAX_READERS
+                                << " threads read concurrently, raise ConnPolicy::readers." << RTT::endlog();
+                return;
+            }
+            int reading = latest;
+            // if this fails, the writer already filled in the newest buffer for us.
+            if ( !os::CAS(&slots[slot], REQUEST, reading) )
+                reading = slots[slot];
+            pull = data[reading].data;
+            os::CAS(&slots[slot], reading, FREE);
+        }
+
+        /**
+         * Set the data to a certain value (non blocking).
+         *
+         * @param push The data which must be set.
+         */
+        virtual void Set( const DataType& push )
+        {
+            // With MAX_READERS + 2 buffers, one is always free.
+            int newest = latest;
+            int writing = newest;
+            do {
+                writing = (writing + 1) % BUF_LEN;
+            } while ( !isFree(writing) );
+            data[writing].data = push;
+            os::CAS(&latest, newest, writing);
+            // the readers that did not see the new sample read it now.
+            for (unsigned int i = 0; i != MAX_READERS; ++i)
+                if ( slots[i] == REQUEST )
+                    os::CAS(&slots[i], REQUEST, writing);
+        }
+
+        virtual void data_sample( const DataType& sample ) {
+            // prepare the buffer.
+            for (unsigned int i = 0; i != BUF_LEN; ++i)
+                data[i].data = sample;
+        }
+    };
+}}
+
+#endif
@@ -56,6 +56,14 @@ namespace RTT {
     {
     }
 
+    TaskCore::TaskCore(TaskState initial_state, unsigned int queue_size, bool growable_queues )
+        :  ee( new ExecutionEngine(this, queue_size, growable_queues) )
+           ,mTaskState(initial_state)
+           ,mInitialState(initial_state)
+           ,mTargetState(initial_state)
+    {
+    }
+
     TaskCore::TaskCore( ExecutionEngine* parent, TaskState initial_state /*= Stopped*/  )
         :  ee( parent )
            ,mTaskState(initial_state)
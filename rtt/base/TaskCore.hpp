@@ -115,6 +115,17 @@ namespace RTT
          */
         TaskCore( TaskState initial_state = Stopped  );
 
+        /**
+         * Create a TaskCore with a new ExecutionEngine of which the message
+         * and function queues hold \a queue_size elements.
+         * @param initial_state Provide the \a PreOperational parameter flag here
+         * to force users in calling configure(), before they call start().
+         * @param queue_size The size of the queues of the ExecutionEngine.
+         * @param growable_queues If true, the queues grow when they are full,
+         * using a preallocated pool shared by all components.
+         */
+        TaskCore( TaskState initial_state, unsigned int queue_size, bool growable_queues = false );
+
         /**
          * Create a TaskCore.
          * Its commands programs and state machines are processed by \a parent.
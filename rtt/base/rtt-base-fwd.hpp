@@ -44,6 +44,10 @@ namespace RTT {
         class DataObjectLocked;
         template<class T>
         class DataObjectUnSync;
+        template<class T>
+        class DataObjectWaitFree;
+        template<class T>
+        class DataObjectSeqLock;
         template<typename T>
         class ChannelElement;
     }
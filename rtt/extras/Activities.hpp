@@ -49,6 +49,8 @@
 #include "SlaveActivity.hpp"
 #include "SequentialActivity.hpp"
 #include "PeriodicActivity.hpp"
+#include "PoolActivity.hpp"
+#include "SchedulerActivity.hpp"
 #include "../Activity.hpp"
 #include "../base/RunnableInterface.hpp"
 
@@ -60,6 +60,10 @@
 
 #endif
 
+#ifdef OS_HAVE_EPOLL
+#include <sys/epoll.h>
+#endif
+
 #include <boost/cstdint.hpp>
 
 using namespace RTT;
@@ -77,6 +81,8 @@ const char FileDescriptorActivity::CMD_ANY_COMMAND;
  */
 FileDescriptorActivity::FileDescriptorActivity(int priority, RunnableInterface* _r, const std::string& name )
     : Activity(priority, 0.0, _r, name)
+    , m_backend(Select)
+    , m_epoll_fd(-1)
     , m_running(false)
     , m_timeout_us(0)
     , m_period(0)
@@ -102,6 +108,8 @@ FileDescriptorActivity::FileDescriptorActivity(int priority, RunnableInterface*
  */
 FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, RunnableInterface* _r, const std::string& name )
     : Activity(scheduler, priority, 0.0, _r, name)
+    , m_backend(Select)
+    , m_epoll_fd(-1)
     , m_running(false)
     , m_timeout_us(0)
     , m_period(0)
@@ -118,6 +126,8 @@ FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Runn
 
 FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Seconds period, RunnableInterface* _r, const std::string& name )
     : Activity(scheduler, priority, 0.0, _r, name)	// actual period == 0.0
+    , m_backend(Select)
+    , m_epoll_fd(-1)
     , m_running(false)
     , m_timeout_us(0)
     , m_period(period >= 0.0 ? period : 0.0)        // intended period
@@ -134,6 +144,8 @@ FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Seco
 
 FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Seconds period, unsigned cpu_affinity, RunnableInterface* _r, const std::string& name )
     : Activity(scheduler, priority, 0.0, cpu_affinity, _r, name)	// actual period == 0.0
+    , m_backend(Select)
+    , m_epoll_fd(-1)
     , m_running(false)
     , m_timeout_us(0)
     , m_period(period >= 0.0 ? period : 0.0)        // intended period
@@ -148,11 +160,46 @@ FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, Seco
     m_interrupt_pipe[0] = m_interrupt_pipe[1] = -1;
 }
 
+FileDescriptorActivity::FileDescriptorActivity(Backend backend, int scheduler, int priority, RunnableInterface* _r, const std::string& name )
+    : Activity(scheduler, priority, 0.0, _r, name)
+    , m_backend(Select)
+    , m_epoll_fd(-1)
+    , m_running(false)
+    , m_timeout_us(0)
+    , m_period(0)
+    , m_has_error(false)
+    , m_has_timeout(false)
+    , m_break_loop(false)
+    , m_trigger(false)
+    , m_update_sets(false)
+{
+    FD_ZERO(&m_fd_set);
+    FD_ZERO(&m_fd_work);
+    m_interrupt_pipe[0] = m_interrupt_pipe[1] = -1;
+    if (backend == Epoll)
+    {
+#ifdef OS_HAVE_EPOLL
+        m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (m_epoll_fd != -1)
+            m_backend = Epoll;
+        else
+            log(Error) << "FileDescriptorActivity: could not create the epoll set, errno = " << errno << ". Using select()." << endlog();
+#else
+        log(Warning) << "FileDescriptorActivity: epoll is not available on this system. Using select()." << endlog();
+#endif
+    }
+}
+
 FileDescriptorActivity::~FileDescriptorActivity()
 {
     stop();
+    if (m_epoll_fd != -1)
+        close(m_epoll_fd);
 }
 
+FileDescriptorActivity::Backend FileDescriptorActivity::getBackend() const
+{ return m_backend; }
+
 Seconds FileDescriptorActivity::getPeriod() const
 { return m_period; }
 
@@ -186,6 +233,10 @@ void FileDescriptorActivity::setTimeout_us(int timeout_us)
     }
 }
 void FileDescriptorActivity::watch(int fd)
+{
+    watch(fd, LevelTriggered);
+}
+void FileDescriptorActivity::watch(int fd, int mode)
 { RTT::os::MutexLock lock(m_lock);
     if (fd < 0)
     {
@@ -193,18 +244,59 @@ void FileDescriptorActivity::watch(int fd)
         return;
     }
 
-    m_watched_fds.insert(fd);
-    FD_SET(fd, &m_fd_set);
+#ifdef OS_HAVE_EPOLL
+    if (m_backend == Epoll)
+    {
+        epoll_event event;
+        event.events = EPOLLIN;
+        if (mode & EdgeTriggered)
+            event.events |= EPOLLET;
+        if (mode & OneShot)
+            event.events |= EPOLLONESHOT;
+        event.data.fd = fd;
+        int op = m_watched_fds.count(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+        if (epoll_ctl(m_epoll_fd, op, fd, &event) == -1)
+        {
+            log(Error) << "FileDescriptorActivity: could not watch file descriptor " << fd << ", errno = " << errno << endlog();
+            return;
+        }
+    }
+    else
+#endif
+    {
+        if (fd >= FD_SETSIZE)
+        {
+            log(Error) << "FileDescriptorActivity: file descriptor " << fd << " is too large for select(), use the Epoll backend" << endlog();
+            return;
+        }
+        if (mode & EdgeTriggered)
+            log(Warning) << "FileDescriptorActivity: edge-triggered watches require the Epoll backend, watching file descriptor " << fd << " level-triggered" << endlog();
+        FD_SET(fd, &m_fd_set);
+    }
+
+    m_watched_fds[fd] = mode;
     triggerUpdateSets();
 }
 void FileDescriptorActivity::unwatch(int fd)
 { RTT::os::MutexLock lock(m_lock);
-    m_watched_fds.erase(fd);
-    FD_CLR(fd, &m_fd_set);
+    if ( m_watched_fds.erase(fd) == 0 )
+        return;
+#ifdef OS_HAVE_EPOLL
+    if (m_backend == Epoll)
+        // fails if fd was already closed, which removed it from the set.
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, 0);
+    else
+#endif
+        FD_CLR(fd, &m_fd_set);
     triggerUpdateSets();
 }
 void FileDescriptorActivity::clearAllWatches()
 { RTT::os::MutexLock lock(m_lock);
+#ifdef OS_HAVE_EPOLL
+    if (m_backend == Epoll)
+        for (std::map<int, int>::iterator it = m_watched_fds.begin(); it != m_watched_fds.end(); ++it)
+            epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->first, 0);
+#endif
     m_watched_fds.clear();
     FD_ZERO(&m_fd_set);
     triggerUpdateSets();
@@ -218,14 +310,16 @@ void FileDescriptorActivity::triggerUpdateSets()
     unused = write(m_interrupt_pipe[1], &CMD_ANY_COMMAND, 1);
 }
 bool FileDescriptorActivity::isUpdated(int fd) const
-{ return FD_ISSET(fd, &m_fd_work); }
+{ return std::binary_search(m_updated_fds.begin(), m_updated_fds.end(), fd); }
+const std::vector<int>& FileDescriptorActivity::getUpdatedFDs() const
+{ return m_updated_fds; }
 bool FileDescriptorActivity::hasError() const
 { return m_has_error; }
 bool FileDescriptorActivity::hasTimeout() const
 { return m_has_timeout; }
 bool FileDescriptorActivity::isWatched(int fd) const
 { RTT::os::MutexLock lock(m_lock);
-    return FD_ISSET(fd, &m_fd_set); }
+    return m_watched_fds.count(fd) != 0; }
 
 bool FileDescriptorActivity::start()
 {
@@ -254,6 +348,24 @@ bool FileDescriptorActivity::start()
     }
 #endif
 
+#ifdef OS_HAVE_EPOLL
+    if (m_backend == Epoll)
+    {
+        // closing the pipe in loop() or stop() removes it from the set again.
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = m_interrupt_pipe[0];
+        if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_interrupt_pipe[0], &event) == -1)
+        {
+            close(m_interrupt_pipe[0]);
+            close(m_interrupt_pipe[1]);
+            m_interrupt_pipe[0] = m_interrupt_pipe[1] = -1;
+            log(Error) << "FileDescriptorActivity: could not add the control pipe to the epoll set" << endlog();
+            return false;
+        }
+    }
+#endif
+
     // reset flags
     m_break_loop = false;
     m_trigger = false;
@@ -300,70 +412,102 @@ void FileDescriptorActivity::loop()
     fd_watch watch_pipe_0(m_interrupt_pipe[0]);
     fd_watch watch_pipe_1(m_interrupt_pipe[1]);
 
+#ifdef OS_HAVE_EPOLL
+    std::vector<epoll_event> events;
+    { RTT::os::MutexLock lock(m_lock);
+        events.resize(m_watched_fds.size() + 1);
+        m_updated_fds.reserve(m_watched_fds.size());
+    }
+#endif
+
     while(true)
     {
-        int max_fd;
-        { RTT::os::MutexLock lock(m_lock);
-            if (m_watched_fds.empty())
-                max_fd = pipe;
-            else
-                max_fd = std::max(pipe, *m_watched_fds.rbegin());
-
-            m_fd_work = m_fd_set;
-        }
-        FD_SET(pipe, &m_fd_work);
-
         int ret;
+        bool pipe_ready = false;
         m_running = false;
-        if (m_timeout_us == 0)
+        m_updated_fds.clear();
+#ifdef OS_HAVE_EPOLL
+        if (m_backend == Epoll)
         {
-            ret = select(max_fd + 1, &m_fd_work, NULL, NULL, NULL);
+            // epoll_wait() only offers a millisecond timeout, round up.
+            int timeout_ms = (m_timeout_us == 0) ? -1 : (m_timeout_us + 999) / 1000;
+            ret = epoll_wait(m_epoll_fd, &events[0], events.size(), timeout_ms);
+            for (int i = 0; i < ret; ++i)
+            {
+                if (events[i].data.fd == pipe)
+                    pipe_ready = true;
+                else
+                    m_updated_fds.push_back(events[i].data.fd);
+            }
+            std::sort(m_updated_fds.begin(), m_updated_fds.end());
         }
         else
+#endif
         {
-			static const int USECS_PER_SEC = 1000000;
-            timeval timeout = { m_timeout_us / USECS_PER_SEC,
-                                m_timeout_us % USECS_PER_SEC};
-            ret = select(max_fd + 1, &m_fd_work, NULL, NULL, &timeout);
+            int max_fd;
+            { RTT::os::MutexLock lock(m_lock);
+                if (m_watched_fds.empty())
+                    max_fd = pipe;
+                else
+                    max_fd = std::max(pipe, m_watched_fds.rbegin()->first);
+
+                m_fd_work = m_fd_set;
+            }
+            FD_SET(pipe, &m_fd_work);
+
+            if (m_timeout_us == 0)
+            {
+                ret = select(max_fd + 1, &m_fd_work, NULL, NULL, NULL);
+            }
+            else
+            {
+                static const int USECS_PER_SEC = 1000000;
+                timeval timeout = { m_timeout_us / USECS_PER_SEC,
+                                    m_timeout_us % USECS_PER_SEC};
+                ret = select(max_fd + 1, &m_fd_work, NULL, NULL, &timeout);
+            }
+
+            if (ret > 0)
+            { RTT::os::MutexLock lock(m_lock);
+                pipe_ready = FD_ISSET(pipe, &m_fd_work);
+                for (std::map<int, int>::iterator it = m_watched_fds.begin(); it != m_watched_fds.end(); ++it)
+                {
+                    if (FD_ISSET(it->first, &m_fd_work))
+                    {
+                        m_updated_fds.push_back(it->first);
+                        // a one-shot watch is disabled until it is watched again.
+                        if (it->second & OneShot)
+                            FD_CLR(it->first, &m_fd_set);
+                    }
+                }
+            }
         }
 
         m_has_error   = false;
         m_has_timeout = false;
         if (ret == -1)
         {
-            log(Error) << "FileDescriptorActivity: error in select(), errno = " << errno << endlog();
+            log(Error) << "FileDescriptorActivity: error in " << (m_backend == Epoll ? "epoll_wait()" : "select()") << ", errno = " << errno << endlog();
             m_has_error = true;
         }
         else if (ret == 0)
         {
-            log(Error) << "FileDescriptorActivity: timeout in select()" << endlog();
+            log(Error) << "FileDescriptorActivity: timeout in " << (m_backend == Epoll ? "epoll_wait()" : "select()") << endlog();
             m_has_timeout = true;
         }
 
         // Empty all commands queued in the pipe
-        if (ret > 0 && FD_ISSET(pipe, &m_fd_work)) // breakLoop or trigger requests
+        if (pipe_ready) // breakLoop or trigger requests
         {
-            // These variables are used in order to loop with select(). See the
-            // while() condition below.
-            fd_set watch_pipe;
-            timeval timeout;
-            char dummy;
-            do
-            {
-                int unused; (void)unused;
-                unused = read(pipe, &dummy, 1);
-
-                // Initialize the values for the next select() call
-                FD_ZERO(&watch_pipe);
-                FD_SET(pipe, &watch_pipe);
-                timeout.tv_sec  = 0;
-                timeout.tv_usec = 0;
-            }
-            while(select(pipe + 1, &watch_pipe, NULL, NULL, &timeout) > 0);
+            // The pipe is non-blocking, read until it is empty.
+            char dummy[16];
+            while (read(pipe, dummy, sizeof(dummy)) > 0)
+                ;
         }
 
         // We check the flags after the command queue was emptied as we could miss commands otherwise:
         bool do_trigger = true;
+        bool update_sets = false;
         { RTT::os::MutexLock lock(m_command_mutex);
             // This section should be really fast to not block threads calling trigger(), breakLoop() or watch().
             if (m_trigger) {
@@ -372,7 +516,10 @@ void FileDescriptorActivity::loop()
             }
             if (m_update_sets) {
                 m_update_sets = false;
-                do_trigger = false;
+                update_sets = true;
+                // edge-triggered and one-shot events are not reported again,
+                // a one-shot fd is already disabled in both backends.
+                do_trigger = !m_updated_fds.empty();
             }
             if (m_break_loop) {
                 m_break_loop = false;
@@ -380,6 +527,16 @@ void FileDescriptorActivity::loop()
             }
         }
 
+#ifdef OS_HAVE_EPOLL
+        if (update_sets && m_backend == Epoll)
+        { RTT::os::MutexLock lock(m_lock);
+            events.resize(m_watched_fds.size() + 1);
+            m_updated_fds.reserve(m_watched_fds.size());
+        }
+#else
+        (void)update_sets;
+#endif
+
         if (do_trigger)
         {
             try
@@ -41,7 +41,8 @@
 
 #include "FileDescriptorActivityInterface.hpp"
 #include "../Activity.hpp"
-#include <set>
+#include <map>
+#include <vector>
 
 namespace RTT { namespace extras {
 
@@ -100,11 +101,59 @@ namespace RTT { namespace extras {
      *   }
      * }
      * </code>
+     *
+     * All file descriptors which were updated at a step() are also returned
+     * by getUpdatedFDs(), such that a component watching many file
+     * descriptors does not need to call isUpdated() for each of them.
+     *
+     * By default, the activity waits with select(), which is limited to file
+     * descriptors below FD_SETSIZE. Construct it with the Epoll backend to
+     * watch many file descriptors, or to use edge-triggered or one-shot
+     * watches (see watch(int, int)).
      */
     class RTT_API FileDescriptorActivity : public extras::FileDescriptorActivityInterface,
                                            public Activity
     {
-        std::set<int> m_watched_fds;
+    public:
+        /**
+         * The system call the activity uses to wait for its file descriptors.
+         */
+        enum Backend {
+            /** select(), which is available on all systems. */
+            Select,
+            /**
+             * epoll(7), which keeps the watched file descriptors in the
+             * kernel. Only available on Linux, the activity falls back to
+             * Select on other systems.
+             */
+            Epoll
+        };
+
+        /**
+         * Flags for watch(int, int).
+         */
+        enum WatchMode {
+            /** Report the file descriptor as long as it has data. */
+            LevelTriggered = 0,
+            /**
+             * Only report the file descriptor when new data arrives.
+             * step() must read until the read would block. Requires
+             * the Epoll backend, Select watches level-triggered.
+             */
+            EdgeTriggered = 1,
+            /**
+             * Report the file descriptor once, until it is watched again.
+             */
+            OneShot = 2
+        };
+
+    private:
+        /** The watched file descriptors and their WatchMode */
+        std::map<int, int> m_watched_fds;
+        /** The file descriptors which were updated at this step(), sorted */
+        std::vector<int> m_updated_fds;
+        Backend m_backend;
+        int  m_epoll_fd;
         bool m_running;
         int  m_interrupt_pipe[2];
         int  m_timeout_us;		//! timeout in microseconds
@@ -179,6 +228,19 @@ namespace RTT { namespace extras {
         FileDescriptorActivity(int scheduler, int priority, Seconds period, unsigned cpu_affinity,
 							   base::RunnableInterface* _r = 0, const std::string& name ="FileDescriptorActivity" );
 
+        /**
+         * Create a FileDescriptorActivity which waits with \a backend.
+         * @param backend Select or Epoll.
+         * @param scheduler
+         *        The scheduler in which the activitie's thread must run. Use ORO_SCHED_OTHER or
+         *        ORO_SCHED_RT.
+         * @param priority The priority of the underlying thread.
+         * @param _r The optional runner, if none, this->loop() is called.
+         * @param name The name of the underlying thread.
+         */
+        FileDescriptorActivity(Backend backend, int scheduler, int priority,
+                               base::RunnableInterface* _r = 0, const std::string& name ="FileDescriptorActivity" );
+
         virtual ~FileDescriptorActivity();
 
         bool isRunning() const;
@@ -197,6 +259,17 @@ namespace RTT { namespace extras {
          */
         void watch(int fd);
 
+        /** Sets a file descriptor the activity should be listening to, or
+         * changes the mode of a watched file descriptor. A one-shot watch
+         * is re-armed by watching it again.
+         *
+         * This method is thread-safe, i.e. it can be called from any thread
+         *
+         * @param fd the file descriptor
+         * @param mode LevelTriggered or a combination of the WatchMode flags
+         */
+        void watch(int fd, int mode);
+
         /** Removes a file descriptor from the set of watched FDs
          *
          * This method is thread-safe, i.e. it can be called from any thread
@@ -224,6 +297,20 @@ namespace RTT { namespace extras {
          */
         bool isUpdated(int fd) const;
 
+        /** The file descriptors which have new data or an error, in
+         * increasing order.
+         *
+         * This should only be used from within the base::RunnableInterface this
+         * activity is driving, i.e. in TaskContext::updateHook() or
+         * TaskContext::errorHook().
+         */
+        const std::vector<int>& getUpdatedFDs() const;
+
+        /** The backend this activity waits with. This is Select if Epoll
+         * was requested, but is not available.
+         */
+        Backend getBackend() const;
+
         /** True if the base::RunnableInterface has been triggered because of a
          * timeout, instead of because of new data is available.
          *
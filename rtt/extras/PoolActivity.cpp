@@ -0,0 +1,272 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  PoolActivity.cpp
+
+                        PoolActivity.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PoolActivity.hpp"
+#include "../os/MutexLock.hpp"
+
+namespace RTT {
+    using namespace extras;
+    using namespace base;
+
+    PoolActivity::PoolActivity( Seconds period, RunnableInterface* run, ThreadPoolPtr pool )
+        : ActivityInterface(run), mpool(pool), mperiod(period), mtimer_id(-1),
+          mactive(false), mqueued(false), mretrigger(false), mworker(0)
+    {
+        if ( !mpool )
+            mpool = ThreadPool::Instance();
+        if ( mperiod < 0.0 )
+            mperiod = 0.0;
+    }
+
+    PoolActivity::~PoolActivity()
+    {
+        stop();
+    }
+
+    ThreadPoolPtr PoolActivity::getThreadPool() const
+    {
+        return mpool;
+    }
+
+    Seconds PoolActivity::getPeriod() const
+    {
+        return mperiod;
+    }
+
+    bool PoolActivity::setPeriod(Seconds s)
+    {
+        if ( s < 0.0 )
+            return false;
+        if ( !isActive() ) {
+            mperiod = s;
+            return true;
+        }
+        if ( mperiod == 0.0 || s == 0.0 )
+            return mperiod == s;
+        if ( !mpool->setTimerPeriod(mtimer_id, s) )
+            return false;
+        mperiod = s;
+        return true;
+    }
+
+    unsigned PoolActivity::getCpuAffinity() const
+    {
+        return ~0;
+    }
+
+    bool PoolActivity::setCpuAffinity(unsigned cpu)
+    {
+        return false;
+    }
+
+    os::ThreadInterface* PoolActivity::thread()
+    {
+        os::MutexLock lock(mlock);
+        return mworker ? mworker : mpool->getWorker(0);
+    }
+
+    bool PoolActivity::initialize()
+    {
+        return true;
+    }
+
+    void PoolActivity::step()
+    {
+    }
+
+    void PoolActivity::loop()
+    {
+        this->step();
+    }
+
+    bool PoolActivity::breakLoop()
+    {
+        return false;
+    }
+
+    void PoolActivity::finalize()
+    {
+    }
+
+    bool PoolActivity::start()
+    {
+        if ( isActive() )
+            return false;
+
+        if ( !(runner ? runner->initialize() : this->initialize()) )
+            return false;
+
+        {
+            os::MutexLock lock(mlock);
+            mactive = true;
+        }
+
+        if ( mperiod > 0.0 ) {
+            mtimer_id = mpool->addTimer(this, mperiod);
+            if ( mtimer_id < 0 ) {
+                {
+                    os::MutexLock lock(mlock);
+                    mactive = false;
+                }
+                if (runner) runner->finalize(); else this->finalize();
+                return false;
+            }
+        }
+        // Like a thread, execute once when started.
+        trigger();
+        return true;
+    }
+
+    bool PoolActivity::stop()
+    {
+        {
+            os::MutexLock lock(mlock);
+            if ( !mactive )
+                return false;
+            mactive = false;
+            mretrigger = false;
+        }
+
+        if ( mtimer_id >= 0 ) {
+            mpool->removeTimer(mtimer_id);
+            mtimer_id = -1;
+        }
+        // Since we are no longer active, the pool will not queue us
+        // again, and after this call no worker can take us any more.
+        mpool->unschedule(this);
+
+        bool busy;
+        {
+            os::MutexLock lock(mlock);
+            mqueued = false;
+            // when stop() is called from within step() or loop(),
+            // waiting would dead-lock.
+            busy = mworker && !mworker->isSelf();
+        }
+        if ( busy ) {
+            if ( mperiod == 0.0 ) {
+                if (runner) runner->breakLoop(); else this->breakLoop();
+            }
+            os::MutexLock lock(mlock);
+            while ( mworker )
+                mdone.wait(mlock);
+        }
+
+        if (runner) runner->finalize(); else this->finalize();
+        return true;
+    }
+
+    bool PoolActivity::isRunning() const
+    {
+        os::MutexLock lock(mlock);
+        return mperiod == 0.0 ? mworker != 0 : mactive;
+    }
+
+    bool PoolActivity::isPeriodic() const
+    {
+        return mperiod != 0.0;
+    }
+
+    bool PoolActivity::isActive() const
+    {
+        os::MutexLock lock(mlock);
+        return mactive;
+    }
+
+    bool PoolActivity::execute()
+    {
+        return false;
+    }
+
+    bool PoolActivity::trigger()
+    {
+        {
+            os::MutexLock lock(mlock);
+            if ( !mactive )
+                return false;
+            if ( mqueued )
+                return true;
+            if ( mworker ) {
+                mretrigger = true;
+                return true;
+            }
+        }
+        return mpool->schedule(this);
+    }
+
+    bool PoolActivity::enqueue(bool& queue)
+    {
+        os::MutexLock lock(mlock);
+        queue = false;
+        if ( !mactive )
+            return false;
+        if ( mworker )
+            mretrigger = true;
+        else if ( !mqueued )
+            queue = mqueued = true;
+        return true;
+    }
+
+    void PoolActivity::claim(os::Thread* worker)
+    {
+        os::MutexLock lock(mlock);
+        mqueued = false;
+        mworker = worker;
+    }
+
+    void PoolActivity::work()
+    {
+        if ( mperiod > 0.0 ) {
+            if (runner) runner->step(); else this->step();
+        } else {
+            if (runner) runner->loop(); else this->loop();
+        }
+    }
+
+    bool PoolActivity::release()
+    {
+        os::MutexLock lock(mlock);
+        mworker = 0;
+        mdone.broadcast();
+        if ( !mactive || !mretrigger )
+            return false;
+        mretrigger = false;
+        mqueued = true;
+        return true;
+    }
+}
@@ -0,0 +1,190 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  PoolActivity.hpp
+
+                        PoolActivity.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_POOL_ACTIVITY_HPP
+#define ORO_POOL_ACTIVITY_HPP
+
+#include "../base/ActivityInterface.hpp"
+#include "../base/RunnableInterface.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/Condition.hpp"
+#include "ThreadPool.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    /**
+     * @brief An activity which is executed by the worker threads of a ThreadPool,
+     * instead of by a thread of its own.
+     *
+     * Use this activity for the many non real-time components of an
+     * application: the number of threads then follows the number of
+     * workers in the pool, and not the number of components. An activity
+     * is never executed by two workers at the same time, but it may be
+     * executed by another worker each time it runs. Operations with
+     * an OwnThread policy are executed by the worker which runs the activity.
+     *
+     * A component which blocks in a worker delays the other activities
+     * of the pool, unless another worker steals them. Use an Activity
+     * for components with real-time or blocking behaviour.
+     *
+     * \section ExecReact Reactions to execute():
+     * Always returns false.
+     *
+     * \section TrigReact Reactions to trigger():
+     * Queues the activity with the pool, unless it is already queued.
+     * If the activity is being executed, it is queued again once it
+     * returns. The non periodic activity executes loop() and
+     * the periodic activity executes step().
+     *
+     * \section Periodic behaviour
+     * A periodic activity is triggered by the timer of the pool. If it is
+     * still being executed when its period expires, it is executed once
+     * more directly afterwards.
+     *
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API PoolActivity
+        :public base::ActivityInterface
+    {
+    public:
+        /**
+         * Create an activity which is executed by the workers of \a pool.
+         * @param period The period in seconds, or zero for a non periodic activity.
+         * @param run Run this instance.
+         * @param pool The pool to use, or null to use ThreadPool::Instance().
+         */
+        PoolActivity( Seconds period = 0.0, base::RunnableInterface* run = 0,
+                      ThreadPoolPtr pool = ThreadPoolPtr() );
+
+        /**
+         * Stops the activity and notifies the base::RunnableInterface that we are gone.
+         */
+        ~PoolActivity();
+
+        /**
+         * Returns the pool which executes this activity.
+         */
+        ThreadPoolPtr getThreadPool() const;
+
+        Seconds getPeriod() const;
+
+        /**
+         * Change the period. A running activity can not switch between
+         * periodic and non periodic execution.
+         */
+        bool setPeriod(Seconds s);
+
+        unsigned getCpuAffinity() const;
+
+        bool setCpuAffinity(unsigned cpu);
+
+        /**
+         * Returns the worker which executes this activity, or the
+         * first worker of the pool when it is not being executed.
+         */
+        os::ThreadInterface* thread();
+
+        bool initialize();
+        void step();
+        void loop();
+        bool breakLoop();
+        void finalize();
+
+        bool start();
+
+        /**
+         * Stops the activity and waits until the pool no longer
+         * executes it, unless it is called from within the activity.
+         */
+        bool stop();
+
+        bool isRunning() const;
+
+        bool isPeriodic() const;
+
+        bool isActive() const;
+
+        bool execute();
+
+        bool trigger();
+
+    private:
+        friend class ThreadPool;
+
+        /**
+         * Called by the pool with a queue locked.
+         * @param queue Set to true if the activity must be queued.
+         * @return false if the activity is not active.
+         */
+        bool enqueue(bool& queue);
+
+        /**
+         * Called by the pool with a queue locked, when \a worker took us.
+         */
+        void claim(os::Thread* worker);
+
+        /**
+         * Execute step() or loop() in the worker which claimed us.
+         */
+        void work();
+
+        /**
+         * Called by the pool with a queue locked, after work().
+         * @return true if the activity must be queued again.
+         */
+        bool release();
+
+        ThreadPoolPtr mpool;
+        Seconds mperiod;
+        int mtimer_id;
+
+        /**
+         * Guards the fields below, which change on
+         * trigger() and when a worker executes us.
+         */
+        mutable os::Mutex mlock;
+        os::Condition mdone;
+        bool mactive;
+        bool mqueued;
+        bool mretrigger;
+        os::Thread* mworker;
+    };
+
+}}
+
+#endif
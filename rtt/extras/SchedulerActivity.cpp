@@ -0,0 +1,301 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  SchedulerActivity.cpp
+
+                        SchedulerActivity.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "SchedulerActivity.hpp"
+#include "SlaveActivity.hpp"
+#include "../TaskContext.hpp"
+#include "../DataFlowInterface.hpp"
+#include "../base/InputPortInterface.hpp"
+#include "../base/OutputPortInterface.hpp"
+#include "../internal/ConnectionManager.hpp"
+#include "../internal/ParallelLanes.hpp"
+#include "../os/MutexLock.hpp"
+#include "../os/TimeService.hpp"
+#include "../Logger.hpp"
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/bind.hpp>
+
+namespace RTT {
+    using namespace extras;
+    using namespace base;
+    using namespace os;
+
+    namespace {
+        /**
+         * Returns true if an output port of \a from is connected
+         * to an input port of \a to.
+         */
+        bool feeds(TaskContext* from, TaskContext* to)
+        {
+            DataFlowInterface::Ports outs = from->ports()->getPorts();
+            DataFlowInterface::Ports ins = to->ports()->getPorts();
+            for (DataFlowInterface::Ports::iterator o = outs.begin(); o != outs.end(); ++o) {
+                OutputPortInterface* out = dynamic_cast<OutputPortInterface*>(*o);
+                if ( !out || !out->connected() )
+                    continue;
+                std::list<internal::ConnectionManager::ChannelDescriptor> channels = out->getManager()->getChannels();
+                for (DataFlowInterface::Ports::iterator i = ins.begin(); i != ins.end(); ++i) {
+                    if ( !dynamic_cast<InputPortInterface*>(*i) )
+                        continue;
+                    boost::scoped_ptr<internal::ConnID> id( (*i)->getPortID() );
+                    for (std::list<internal::ConnectionManager::ChannelDescriptor>::iterator c = channels.begin(); c != channels.end(); ++c)
+                        if ( c->get<0>() && c->get<0>()->isSameID(*id) )
+                            return true;
+                }
+            }
+            return false;
+        }
+
+        unsigned int root(std::vector<unsigned int>& parent, unsigned int i)
+        {
+            while ( parent[i] != i )
+                i = parent[i] = parent[ parent[i] ];
+            return i;
+        }
+    }
+
+    SchedulerActivity::SchedulerActivity(int scheduler, int priority, Seconds period,
+                                         unsigned cpu_affinity, const std::string& name)
+        : Activity(scheduler, priority, period, cpu_affinity, 0, name),
+          mlanes(1), mparallel(0), mchanged(true), mcycle_start(0)
+    {
+        setParallel( std::vector<unsigned>() );
+    }
+
+    SchedulerActivity::~SchedulerActivity()
+    {
+        stop();
+        delete mparallel;
+        for (unsigned int i = 0; i != mentries.size(); ++i)
+            delete mentries[i];
+    }
+
+    bool SchedulerActivity::addComponent(TaskContext* tc, Seconds deadline)
+    {
+        if ( !isActive() ) {
+            log(Error) << "SchedulerActivity " << getName() << ": start() the scheduler before adding components." << endlog();
+            return false;
+        }
+        if ( !tc || tc->isRunning() || find(tc) )
+            return false;
+        Entry* e = new Entry;
+        e->tc = tc;
+        e->name = tc->getName();
+        e->slave = new SlaveActivity(this, tc->engine());
+        e->deadline = Seconds_to_nsecs(deadline);
+        e->completion.Set(0);
+        oro_atomic_set(&e->misses, 0);
+        if ( !tc->setActivity(e->slave) ) {
+            delete e->slave;
+            delete e;
+            return false;
+        }
+        {
+            MutexLock lock(mlock);
+            mentries.push_back(e);
+        }
+        updateSchedule();
+        return true;
+    }
+
+    bool SchedulerActivity::updateSchedule()
+    {
+        MutexLock lock(mlock);
+        unsigned int n = mentries.size();
+
+        // Edges follow the data flow, and connect the branches.
+        std::vector< std::vector<unsigned int> > next(n);
+        std::vector<unsigned int> indegree(n, 0);
+        std::vector<unsigned int> parent(n);
+        for (unsigned int a = 0; a != n; ++a)
+            parent[a] = a;
+        for (unsigned int a = 0; a != n; ++a)
+            for (unsigned int b = 0; b != n; ++b)
+                if ( a != b && feeds(mentries[a]->tc, mentries[b]->tc) ) {
+                    next[a].push_back(b);
+                    ++indegree[b];
+                    parent[ root(parent, a) ] = root(parent, b);
+                }
+
+        // Topological order, which keeps the order of addition
+        // for independent components.
+        bool acyclic = true;
+        std::vector<unsigned int> order;
+        std::vector<bool> done(n, false);
+        while ( order.size() != n ) {
+            unsigned int pick = n;
+            for (unsigned int i = 0; i != n && pick == n; ++i)
+                if ( !done[i] && indegree[i] == 0 )
+                    pick = i;
+            if ( pick == n ) {
+                acyclic = false;
+                for (unsigned int i = 0; i != n && pick == n; ++i)
+                    if ( !done[i] )
+                        pick = i;
+            }
+            done[pick] = true;
+            order.push_back(pick);
+            for (unsigned int s = 0; s != next[pick].size(); ++s)
+                if ( indegree[ next[pick][s] ] )
+                    --indegree[ next[pick][s] ];
+        }
+        if ( !acyclic )
+            log(Warning) << "SchedulerActivity " << getName() << ": the port connections between its components form a cycle, which is broken in the order the components were added." << endlog();
+
+        // Give each branch to the lane with the fewest components.
+        std::vector<unsigned int> branch_size(n, 0);
+        for (unsigned int i = 0; i != n; ++i)
+            ++branch_size[ root(parent, i) ];
+        std::vector<unsigned int> lane_of(n, 0);
+        std::vector<unsigned int> lane_size(mparallel->getLanes(), 0);
+        std::vector<bool> placed(n, false);
+        for (unsigned int i = 0; i != n; ++i) {
+            unsigned int r = root(parent, order[i]);
+            if ( placed[r] )
+                continue;
+            unsigned int lane = 0;
+            for (unsigned int l = 1; l != lane_size.size(); ++l)
+                if ( lane_size[l] < lane_size[lane] )
+                    lane = l;
+            lane_of[r] = lane;
+            lane_size[lane] += branch_size[r];
+            placed[r] = true;
+        }
+
+        mlanes.assign(lane_size.size(), std::vector<unsigned int>());
+        for (unsigned int i = 0; i != n; ++i)
+            mlanes[ lane_of[ root(parent, order[i]) ] ].push_back( order[i] );
+        mchanged = true;
+        return acyclic;
+    }
+
+    std::vector< std::vector<TaskContext*> > SchedulerActivity::getSchedule() const
+    {
+        MutexLock lock(mlock);
+        std::vector< std::vector<TaskContext*> > ret( mlanes.size() );
+        for (unsigned int l = 0; l != mlanes.size(); ++l)
+            for (unsigned int i = 0; i != mlanes[l].size(); ++i)
+                ret[l].push_back( mentries[ mlanes[l][i] ]->tc );
+        return ret;
+    }
+
+    bool SchedulerActivity::setParallel(const std::vector<unsigned>& cpu_affinities)
+    {
+        if ( isActive() )
+            return false;
+        delete mparallel;
+        mparallel = new internal::ParallelLanes( boost::bind(&SchedulerActivity::runLane, this, _1),
+                                                 getScheduler(), getPriority(), cpu_affinities, getName() );
+        updateSchedule();
+        return true;
+    }
+
+    const SchedulerActivity::Entry* SchedulerActivity::find(TaskContext* tc) const
+    {
+        for (unsigned int i = 0; i != mentries.size(); ++i)
+            if ( mentries[i]->tc == tc )
+                return mentries[i];
+        return 0;
+    }
+
+    unsigned int SchedulerActivity::getDeadlineMisses(TaskContext* tc) const
+    {
+        MutexLock lock(mlock);
+        const Entry* e = find(tc);
+        return e ? oro_atomic_read(&e->misses) : 0;
+    }
+
+    Seconds SchedulerActivity::getCompletionTime(TaskContext* tc) const
+    {
+        MutexLock lock(mlock);
+        const Entry* e = find(tc);
+        return e ? nsecs_to_Seconds(e->completion.Get()) : 0.0;
+    }
+
+    bool SchedulerActivity::start()
+    {
+        updateSchedule();
+        return Activity::start();
+    }
+
+    void SchedulerActivity::step()
+    {
+        {
+            // entries are never removed, so the copy stays valid
+            // when components are added during the cycle.
+            MutexLock lock(mlock);
+            if ( mchanged ) {
+                mcycle.assign( mlanes.size(), std::vector<Entry*>() );
+                for (unsigned int l = 0; l != mlanes.size(); ++l)
+                    for (unsigned int i = 0; i != mlanes[l].size(); ++i)
+                        mcycle[l].push_back( mentries[ mlanes[l][i] ] );
+                mchanged = false;
+            }
+        }
+        mcycle_start = TimeService::Instance()->getNSecs();
+        mparallel->run();
+    }
+
+    void SchedulerActivity::runLane(unsigned int lane)
+    {
+        if ( lane >= mcycle.size() )
+            return;
+        for (unsigned int i = 0; i != mcycle[lane].size(); ++i) {
+            Entry& e = *mcycle[lane][i];
+            e.slave->execute();
+            nsecs completion = TimeService::Instance()->getNSecs() - mcycle_start;
+            e.completion.Set(completion);
+            if ( e.deadline != 0 && completion > e.deadline )
+                oro_atomic_inc(&e.misses);
+        }
+    }
+
+    void SchedulerActivity::finalize()
+    {
+        mparallel->stop();
+        // misses are reported here, since the cycle must not log.
+        MutexLock lock(mlock);
+        for (unsigned int i = 0; i != mentries.size(); ++i)
+            if ( oro_atomic_read(&mentries[i]->misses) != 0 )
+                log(Warning) << "SchedulerActivity " << getName() << ": " << mentries[i]->name
+                             << " missed its deadline of " << nsecs_to_Seconds(mentries[i]->deadline) << "s in "
+                             << oro_atomic_read(&mentries[i]->misses) << " cycles." << endlog();
+        Activity::finalize();
+    }
+}
@@ -0,0 +1,203 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  SchedulerActivity.hpp
+
+                        SchedulerActivity.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SCHEDULER_ACTIVITY_HPP
+#define ORO_SCHEDULER_ACTIVITY_HPP
+
+#include <vector>
+#include <string>
+
+#include "../Activity.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/oro_arch.h"
+#include "../base/DataObjectSeqLock.hpp"
+#include "../rtt-fwd.hpp"
+#include "../internal/rtt-internal-fwd.hpp"
+#include "rtt-extras-fwd.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    /**
+     * @brief A periodic activity which executes a chain of components
+     * in the order of their data flow, each cycle.
+     *
+     * Each component added with addComponent() gets a SlaveActivity of
+     * this activity. The execution order follows the port connections
+     * between these components: a component which writes to an input port
+     * of another component is executed before it. The order is computed
+     * when the activity is started, when a component is added, and by
+     * updateSchedule(). Connect the ports before, or call
+     * updateSchedule() afterwards. If the connections form a cycle,
+     * it is broken in the order the components were added.
+     *
+     * Components which do not depend on each other, directly or
+     * indirectly, form independent branches. With setParallel(), these
+     * branches are distributed over helper threads, which execute their
+     * part of the cycle while this thread executes its own part. A cycle
+     * ends when all threads are done.
+     *
+     * A component may be given a deadline, relative to the start of the
+     * cycle. The activity counts the cycles in which the component's
+     * step finished after its deadline, and reports the misses when it
+     * is stopped. The cycle itself neither locks nor logs for this.
+     *
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API SchedulerActivity
+        : public Activity
+    {
+    public:
+        /**
+         * Create a periodic scheduler.
+         *
+         * @param scheduler The scheduler, ORO_SCHED_RT or ORO_SCHED_OTHER.
+         * @param priority The priority of the thread.
+         * @param period The period of the cycle, in seconds.
+         * @param cpu_affinity The cpu affinity of the thread.
+         * @param name The name of the thread.
+         */
+        SchedulerActivity(int scheduler, int priority, Seconds period,
+                          unsigned cpu_affinity = ~0, const std::string& name = "SchedulerActivity");
+
+        /**
+         * Stops the scheduler and its helper threads.
+         * @pre The components added to this scheduler are already
+         * destroyed, or have been given another activity.
+         */
+        ~SchedulerActivity();
+
+        /**
+         * Let this scheduler execute \a tc each cycle.
+         * @pre This activity is started.
+         * @param tc A component which is not running.
+         * @param deadline The time after the start of the cycle at
+         * which \a tc must have finished, or zero to disable monitoring.
+         * @return false if \a tc is running or was already added.
+         */
+        bool addComponent(TaskContext* tc, Seconds deadline = 0.0);
+
+        /**
+         * Recompute the execution order from the current port connections.
+         * The new order takes effect at the start of the next cycle.
+         * @return false if the connections between the components form
+         * a cycle, in which case the order is still updated.
+         */
+        bool updateSchedule();
+
+        /**
+         * Returns the components in the order this thread and its
+         * helpers execute them, one list per thread.
+         */
+        std::vector< std::vector<TaskContext*> > getSchedule() const;
+
+        /**
+         * Execute independent branches of the schedule in helper threads.
+         * @param cpu_affinities One helper thread is created for each entry,
+         * with that cpu affinity. Empty to execute all in this thread.
+         * @return false if this activity is started.
+         */
+        bool setParallel(const std::vector<unsigned>& cpu_affinities);
+
+        /**
+         * Returns the number of cycles in which \a tc finished after its deadline.
+         */
+        unsigned int getDeadlineMisses(TaskContext* tc) const;
+
+        /**
+         * Returns the time after the start of the last cycle at which
+         * \a tc finished, in seconds.
+         */
+        Seconds getCompletionTime(TaskContext* tc) const;
+
+        virtual bool start();
+
+        virtual void step();
+
+        virtual void finalize();
+
+    private:
+        struct Entry {
+            TaskContext* tc;
+            /**
+             * The name of tc, which may be gone when the misses are reported.
+             */
+            std::string name;
+            SlaveActivity* slave;
+            nsecs deadline;
+            /**
+             * Written by the lane which executes this entry,
+             * read by getCompletionTime().
+             */
+            base::DataObjectSeqLock<nsecs> completion;
+            oro_atomic_t misses;
+        };
+
+        /**
+         * Executes lane \a lane of the schedule.
+         */
+        void runLane(unsigned int lane);
+
+        const Entry* find(TaskContext* tc) const;
+
+        /**
+         * Guards the schedule. It is not held during a cycle,
+         * such that the components may query this activity.
+         */
+        mutable os::Mutex mlock;
+        std::vector<Entry*> mentries;
+
+        /**
+         * Indexes in mentries, one list per lane. Lane 0 is
+         * executed by this thread, the others by the helpers of mparallel.
+         */
+        std::vector< std::vector<unsigned int> > mlanes;
+        internal::ParallelLanes* mparallel;
+
+        /**
+         * The lanes executed by the current cycle, copied from mlanes
+         * at the start of a cycle when mchanged is set.
+         */
+        std::vector< std::vector<Entry*> > mcycle;
+        bool mchanged;
+
+        nsecs mcycle_start;
+    };
+
+}}
+
+#endif
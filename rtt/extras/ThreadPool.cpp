@@ -0,0 +1,312 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ThreadPool.cpp
+
+                        ThreadPool.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "ThreadPool.hpp"
+#include "PoolActivity.hpp"
+#include "../os/MutexLock.hpp"
+#include "../os/Timer.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <boost/weak_ptr.hpp>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+namespace RTT {
+    using namespace extras;
+    using namespace os;
+
+    /**
+     * A worker executes the activities of its own queue,
+     * or steals them from the other queues.
+     */
+    class ThreadPool::Worker
+        : public os::Thread
+    {
+        ThreadPool* mpool;
+        unsigned int mindex;
+    public:
+        Worker(ThreadPool* pool, unsigned int index, int scheduler, int priority, const std::string& name)
+            : Thread(scheduler, priority, 0.0, ~0, name), mpool(pool), mindex(index)
+        {}
+
+        void loop() {
+            while ( mpool->waitForWork() ) {
+                PoolActivity* act;
+                while ( (act = mpool->take(mindex)) ) {
+                    act->work();
+                    mpool->finish(act, mindex);
+                }
+            }
+        }
+
+        bool breakLoop() {
+            // the pool sets mquit before stopping us.
+            return true;
+        }
+    };
+
+    /**
+     * Triggers the periodic activities of a pool.
+     */
+    class ThreadPool::PoolTimer
+        : public os::Timer
+    {
+        ThreadPool* mpool;
+    public:
+        PoolTimer(ThreadPool* pool, int scheduler, int priority)
+            : Timer(0, scheduler, priority), mpool(pool)
+        {}
+
+        void timeout(TimerId timer_id) {
+            mpool->timeout(timer_id);
+        }
+    };
+
+    namespace {
+        boost::weak_ptr<ThreadPool> DefaultPool;
+        Mutex DefaultPoolLock;
+    }
+
+    ThreadPoolPtr ThreadPool::Instance()
+    {
+        MutexLock lock(DefaultPoolLock);
+        ThreadPoolPtr ret = DefaultPool.lock();
+        if ( !ret ) {
+            long cpus = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+            cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+            // at least two workers, such that an activity which waits
+            // for another one in the pool can not block the pool.
+            ret.reset( new ThreadPool( std::max(cpus, 2L) ) );
+            DefaultPool = ret;
+        }
+        return ret;
+    }
+
+    ThreadPool::ThreadPool(unsigned int workers, int scheduler, int priority, const std::string& name)
+        : msleepers(0), mquit(false), mtimer(0)
+    {
+        oro_atomic_set(&mqueued, 0);
+        oro_atomic_set(&msteals, 0);
+        oro_atomic_set(&mnext, 0);
+        if (workers == 0)
+            workers = 1;
+        os::CheckPriority(scheduler, priority);
+        for (unsigned int i = 0; i != workers; ++i) {
+            std::stringstream wname;
+            wname << name << i;
+            mqueues.push_back( new WorkQueue() );
+            mworkers.push_back( new Worker(this, i, scheduler, priority, wname.str()) );
+        }
+        for (unsigned int i = 0; i != workers; ++i)
+            mworkers[i]->start();
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        delete mtimer;
+        {
+            MutexLock lock(msleep_lock);
+            mquit = true;
+            mwork.broadcast();
+        }
+        for (unsigned int i = 0; i != mworkers.size(); ++i) {
+            mworkers[i]->stop();
+            delete mworkers[i];
+            delete mqueues[i];
+        }
+    }
+
+    unsigned int ThreadPool::getWorkerCount() const
+    {
+        return mworkers.size();
+    }
+
+    os::Thread* ThreadPool::getWorker(unsigned int i) const
+    {
+        return i < mworkers.size() ? mworkers[i] : 0;
+    }
+
+    unsigned int ThreadPool::getStealCount() const
+    {
+        return oro_atomic_read(&msteals);
+    }
+
+    unsigned int ThreadPool::pick()
+    {
+        for (unsigned int i = 0; i != mworkers.size(); ++i)
+            if ( mworkers[i]->isSelf() )
+                return i;
+        oro_atomic_inc(&mnext);
+        return unsigned(oro_atomic_read(&mnext)) % mqueues.size();
+    }
+
+    bool ThreadPool::schedule(PoolActivity* act)
+    {
+        unsigned int index = pick();
+        bool queued = false;
+        {
+            MutexLock lock(mqueues[index]->lock);
+            // checked with the queue locked, such that stop() can not
+            // miss this activity in unschedule().
+            if ( !act->enqueue(queued) )
+                return false;
+            if (queued) {
+                oro_atomic_inc(&mqueued);
+                mqueues[index]->items.push_back(act);
+            }
+        }
+        if (queued)
+            wake();
+        return true;
+    }
+
+    void ThreadPool::unschedule(PoolActivity* act)
+    {
+        for (unsigned int i = 0; i != mqueues.size(); ++i) {
+            MutexLock lock(mqueues[i]->lock);
+            std::deque<PoolActivity*>& items = mqueues[i]->items;
+            std::deque<PoolActivity*>::iterator it = std::remove(items.begin(), items.end(), act);
+            for (std::deque<PoolActivity*>::iterator r = it; r != items.end(); ++r)
+                oro_atomic_dec(&mqueued);
+            items.erase(it, items.end());
+        }
+    }
+
+    PoolActivity* ThreadPool::take(unsigned int index)
+    {
+        unsigned int n = mqueues.size();
+        for (unsigned int i = 0; i != n; ++i) {
+            WorkQueue* q = mqueues[(index + i) % n];
+            MutexLock lock(q->lock);
+            if ( q->items.empty() )
+                continue;
+            PoolActivity* act;
+            if ( i == 0 ) {
+                // own work in trigger order
+                act = q->items.front();
+                q->items.pop_front();
+            } else {
+                // steal from the other end
+                act = q->items.back();
+                q->items.pop_back();
+                oro_atomic_inc(&msteals);
+            }
+            oro_atomic_dec(&mqueued);
+            // claimed with the queue locked, for the same reason as in schedule().
+            act->claim( mworkers[index] );
+            return act;
+        }
+        return 0;
+    }
+
+    void ThreadPool::finish(PoolActivity* act, unsigned int index)
+    {
+        bool again;
+        {
+            MutexLock lock(mqueues[index]->lock);
+            again = act->release();
+            if (again) {
+                oro_atomic_inc(&mqueued);
+                mqueues[index]->items.push_back(act);
+            }
+        }
+        if (again)
+            wake();
+    }
+
+    bool ThreadPool::waitForWork()
+    {
+        MutexLock lock(msleep_lock);
+        while ( oro_atomic_read(&mqueued) == 0 && !mquit ) {
+            ++msleepers;
+            mwork.wait(msleep_lock);
+            --msleepers;
+        }
+        return !mquit;
+    }
+
+    void ThreadPool::wake()
+    {
+        MutexLock lock(msleep_lock);
+        if (msleepers)
+            mwork.broadcast();
+    }
+
+    int ThreadPool::addTimer(PoolActivity* act, Seconds period)
+    {
+        MutexLock lock(mtimer_lock);
+        if ( !mtimer )
+            mtimer = new PoolTimer(this, mworkers[0]->getScheduler(), mworkers[0]->getPriority());
+        int id = std::find(mtimed.begin(), mtimed.end(), (PoolActivity*)0) - mtimed.begin();
+        if ( id == int(mtimed.size()) ) {
+            mtimed.push_back(0);
+            mtimer->setMaxTimers( mtimed.size() );
+        }
+        if ( !mtimer->startTimer(id, period) )
+            return -1;
+        mtimed[id] = act;
+        return id;
+    }
+
+    bool ThreadPool::setTimerPeriod(int id, Seconds period)
+    {
+        MutexLock lock(mtimer_lock);
+        return mtimer && mtimer->startTimer(id, period);
+    }
+
+    void ThreadPool::removeTimer(int id)
+    {
+        MutexLock lock(mtimer_lock);
+        if ( !mtimer || id < 0 || id >= int(mtimed.size()) )
+            return;
+        mtimer->killTimer(id);
+        mtimed[id] = 0;
+    }
+
+    void ThreadPool::timeout(int id)
+    {
+        MutexLock lock(mtimer_lock);
+        if ( id < int(mtimed.size()) && mtimed[id] )
+            schedule( mtimed[id] );
+    }
+}
@@ -0,0 +1,218 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ThreadPool.hpp
+
+                        ThreadPool.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_THREADPOOL_HPP
+#define ORO_THREADPOOL_HPP
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <boost/shared_ptr.hpp>
+
+#include "../os/Thread.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/Condition.hpp"
+#include "../os/threads.hpp"
+#include "../os/oro_arch.h"
+#include "rtt-extras-fwd.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    /**
+     * ThreadPool objects are reference counted such that
+     * when the last PoolActivity which uses it is deleted,
+     * the worker threads are deleted as well.
+     */
+    typedef boost::shared_ptr<ThreadPool> ThreadPoolPtr;
+
+    /**
+     * A fixed set of worker threads which executes any number of
+     * PoolActivity objects.
+     *
+     * Each worker has its own queue of triggered activities. An activity
+     * triggered from within a worker is queued with that worker, other
+     * triggers are spread over the workers. A worker which runs out
+     * of work steals activities from the queues of the other workers,
+     * and sleeps when all queues are empty. Periodic activities are
+     * triggered by a single os::Timer owned by the pool.
+     *
+     * The pool is meant for the many non real-time components of an
+     * application, which then no longer need one thread each.
+     *
+     * @see PoolActivity
+     */
+    class RTT_API ThreadPool
+    {
+    public:
+        /**
+         * Create a pool and start its worker threads.
+         *
+         * @param workers The number of worker threads, at least one.
+         * @param scheduler The scheduler of the workers, ORO_SCHED_OTHER or ORO_SCHED_RT.
+         * @param priority The priority of the workers.
+         * @param name The name of the pool, the workers are named after it.
+         */
+        ThreadPool(unsigned int workers, int scheduler = ORO_SCHED_OTHER,
+                   int priority = os::LowestPriority, const std::string& name = "ThreadPool");
+
+        /**
+         * Stops and deletes the worker threads.
+         * @pre No PoolActivity uses this pool any more.
+         */
+        ~ThreadPool();
+
+        /**
+         * Returns the default pool, which has one worker per online
+         * processor and is created on first use.
+         */
+        static ThreadPoolPtr Instance();
+
+        /**
+         * Returns the number of worker threads.
+         */
+        unsigned int getWorkerCount() const;
+
+        /**
+         * Returns worker thread \a i, or null if \a i is out of range.
+         */
+        os::Thread* getWorker(unsigned int i) const;
+
+        /**
+         * Returns the number of activities a worker took
+         * from the queue of another worker.
+         */
+        unsigned int getStealCount() const;
+
+    protected:
+        friend class PoolActivity;
+
+        /**
+         * Queue \a act for execution, unless it is stopped,
+         * already queued or being executed.
+         * @return false if \a act is not active.
+         */
+        bool schedule(PoolActivity* act);
+
+        /**
+         * Remove \a act from all queues.
+         */
+        void unschedule(PoolActivity* act);
+
+        /**
+         * Trigger \a act every \a period seconds.
+         * @return the timer id, or -1 if the timer could not be started.
+         */
+        int addTimer(PoolActivity* act, Seconds period);
+
+        /**
+         * Change the period of a timer returned by addTimer().
+         */
+        bool setTimerPeriod(int id, Seconds period);
+
+        /**
+         * Stop a timer returned by addTimer(). Once this function returns,
+         * the timer no longer triggers its activity.
+         */
+        void removeTimer(int id);
+
+    private:
+        class Worker;
+        class PoolTimer;
+
+        struct WorkQueue {
+            os::Mutex lock;
+            std::deque<PoolActivity*> items;
+        };
+
+        /**
+         * Called by the timer thread.
+         */
+        void timeout(int id);
+
+        /**
+         * Returns the queue of the calling worker, or the next
+         * queue in line if the caller is not a worker of this pool.
+         */
+        unsigned int pick();
+
+        /**
+         * Take an activity from the queue of worker \a index, or steal
+         * one from another worker, and mark it as being executed.
+         * @return null if all queues are empty.
+         */
+        PoolActivity* take(unsigned int index);
+
+        /**
+         * Called by worker \a index when it executed \a act.
+         * Requeues it if it was triggered in the mean time.
+         */
+        void finish(PoolActivity* act, unsigned int index);
+
+        /**
+         * Sleep until work is queued.
+         * @return false if the pool is being destroyed.
+         */
+        bool waitForWork();
+
+        /**
+         * Wake up the sleeping workers after an activity was queued.
+         */
+        void wake();
+
+        std::vector<WorkQueue*> mqueues;
+        std::vector<Worker*> mworkers;
+
+        /**
+         * The number of queued activities, in all queues.
+         */
+        oro_atomic_t mqueued;
+        oro_atomic_t msteals;
+        oro_atomic_t mnext;
+
+        os::Mutex msleep_lock;
+        os::Condition mwork;
+        unsigned int msleepers;
+        bool mquit;
+
+        os::Mutex mtimer_lock;
+        std::vector<PoolActivity*> mtimed;
+        PoolTimer* mtimer;
+    };
+}}
+
+#endif
@@ -6,10 +6,13 @@ namespace RTT {
         class FileDescriptorActivity;
         class IRQActivity;
         class PeriodicActivity;
+        class PoolActivity;
+        class SchedulerActivity;
         class SequentialActivity;
         class SimulationActivity;
         class SimulationThread;
         class SlaveActivity;
+        class ThreadPool;
         class TimerThread;
         struct Provider;
         struct RT_INTR;
@@ -39,6 +39,7 @@
 #ifndef ORO_CORELIB_ATOMIC_MWSR_QUEUE_HPP
 #define ORO_CORELIB_ATOMIC_MWSR_QUEUE_HPP
 
+#include "../rtt-config.h"
 #include "../os/CAS.hpp"
 #include <utility>
 
@@ -88,8 +89,13 @@ namespace RTT
             /**
              * The indexes are packed into one double word.
              * Therefore the read and write index can be read and written atomically.
+             * They are padded into a cache line of their own, such that
+             * the CAS of one thread does not evict _size and _buf
+             * from the caches of the other threads.
              */
+            char _pad_before[ORO_CACHE_LINE_SIZE];
             volatile SIndexes _indxes;
+            char _pad_after[ORO_CACHE_LINE_SIZE];
 
             /**
              * Atomic advance and wrap of the Write pointer.
@@ -0,0 +1,185 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  CallPool.hpp
+
+                        CallPool.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_CALL_POOL_HPP
+#define ORO_CALL_POOL_HPP
+
+#include "AtomicQueue.hpp"
+#include <boost/shared_ptr.hpp>
+#include <cstddef>
+#include <cassert>
+#include <new>
+
+namespace RTT
+{
+    namespace internal
+    {
+        /**
+         * A fixed number of equally sized memory blocks, which are taken
+         * and returned without locks. Operation::setMaxPendingCalls()
+         * uses it to store asynchronous calls, such that send() does
+         * not depend on the real-time allocator.
+         */
+        class CallPool
+        {
+            char* mstorage;
+            // The queue is twice as large as the number of blocks, since
+            // an AtomicQueue may report full shortly before its capacity.
+            AtomicQueue<char*> mfree;
+            std::size_t mblock_size;
+            unsigned int mblocks;
+
+            CallPool(const CallPool&);
+        public:
+            typedef boost::shared_ptr<CallPool> shared_ptr;
+
+            /**
+             * Allocates \a blocks blocks of at least \a block_size bytes.
+             */
+            CallPool(unsigned int blocks, std::size_t block_size)
+                : mstorage(0), mfree(2 * blocks),
+                  mblock_size( (block_size + 15) & ~std::size_t(15) ), mblocks(blocks)
+            {
+                mstorage = new char[mblock_size * mblocks];
+                for (unsigned int i = 0; i != mblocks; ++i)
+                    mfree.enqueue( mstorage + i * mblock_size );
+            }
+
+            ~CallPool()
+            {
+                delete[] mstorage;
+            }
+
+            /**
+             * Takes a block.
+             * @return null if all blocks are in use.
+             */
+            void* allocate()
+            {
+                char* block = 0;
+                if ( mfree.dequeue(block) )
+                    return block;
+                return 0;
+            }
+
+            /**
+             * Returns a block which was taken with allocate().
+             */
+            void deallocate(void* block)
+            {
+                bool ok = mfree.enqueue( static_cast<char*>(block) );
+                assert( ok && "CallPool: more blocks returned than allocated.");
+                (void)ok;
+            }
+
+            std::size_t blockSize() const { return mblock_size; }
+
+            unsigned int capacity() const { return mblocks; }
+        };
+
+        /**
+         * An allocator for boost::allocate_shared() which hands out a block
+         * taken from a CallPool before, and returns it to the pool when
+         * the object is destroyed. boost::allocate_shared() allocates exactly
+         * once, the object and its reference count in one block.
+         *
+         * Since the size of that block depends on the allocator type, the
+         * same allocator also measures it: constructed with a \a size pointer,
+         * it records the size and allocates from the heap.
+         */
+        template <class T>
+        class CallPoolAllocator
+        {
+        public:
+            typedef T                 value_type;
+            typedef value_type*       pointer;
+            typedef const value_type* const_pointer;
+            typedef value_type&       reference;
+            typedef const value_type& const_reference;
+            typedef std::size_t       size_type;
+            typedef std::ptrdiff_t    difference_type;
+
+            template <class U>
+            struct rebind { typedef CallPoolAllocator<U> other; };
+
+            CallPoolAllocator(CallPool::shared_ptr pool, void* block)
+                : pool(pool), block(block), size(0) {}
+            CallPoolAllocator(std::size_t* size)
+                : pool(), block(0), size(size) {}
+            template <class U>
+            CallPoolAllocator(const CallPoolAllocator<U>& other)
+                : pool(other.pool), block(other.block), size(other.size) {}
+
+            pointer allocate(size_type n, const void* = 0) {
+                if ( size ) {
+                    if ( n * sizeof(T) > *size )
+                        *size = n * sizeof(T);
+                    return static_cast<pointer>( ::operator new(n * sizeof(T)) );
+                }
+                assert( n * sizeof(T) <= pool->blockSize() );
+                return static_cast<pointer>(block);
+            }
+
+            void deallocate(pointer p, size_type) {
+                if ( size )
+                    ::operator delete(p);
+                else
+                    pool->deallocate(p);
+            }
+
+            size_type max_size() const {
+                return pool ? pool->blockSize() / sizeof(T) : static_cast<size_type>(-1) / sizeof(T);
+            }
+
+            pointer address(reference x) const { return &x; }
+            const_pointer address(const_reference x) const { return &x; }
+            void construct(pointer p, const value_type& x) { new(p) value_type(x); }
+            void destroy(pointer p) { p->~value_type(); }
+
+            bool operator==(const CallPoolAllocator& other) const { return pool == other.pool; }
+            bool operator!=(const CallPoolAllocator& other) const { return pool != other.pool; }
+
+            // Keeps the pool alive as long as a block is in use.
+            CallPool::shared_ptr pool;
+            void* block;
+            std::size_t* size;
+        };
+    }
+}
+
+#endif
@@ -99,6 +99,32 @@ namespace RTT { namespace internal {
             return NoData;
         }
 
+        /** Appends the samples at the end of the FIFO and signals only once.
+         * The samples which do not fit in the FIFO are dropped.
+         */
+        virtual bool writeBatch(std::vector<value_t> const& samples)
+        {
+            if (buffer->Push(samples) != 0)
+                return this->signal();
+            return true;
+        }
+
+        /** Pops all elements of the FIFO and appends them to \a samples.
+         */
+        virtual FlowStatus readAll(std::vector<value_t>& samples)
+        {
+	    value_t *new_sample_p;
+            FlowStatus result = last_sample_p ? OldData : NoData;
+            while ( (new_sample_p = buffer->PopWithoutRelease()) ) {
+		if(last_sample_p)
+		    buffer->Release(last_sample_p);
+		last_sample_p = new_sample_p;
+		samples.push_back(*new_sample_p);
+                result = NewData;
+            }
+            return result;
+        }
+
         /** Removes all elements in the FIFO. After a call to clear(), read()
          * will always return false (provided write() has not been called in the
          * meantime).
@@ -69,6 +69,15 @@ namespace RTT { namespace internal {
             return this->signal();
         }
 
+        /** Only the last sample needs to be stored.
+         */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            if (samples.empty())
+                return true;
+            return write(samples.back());
+        }
+
         /** Reads the last sample given to write()
          *
          * @return false if no sample has ever been written, true otherwise
@@ -0,0 +1,170 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ChannelSharedElement.hpp
+
+                        ChannelSharedElement.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_CHANNEL_SHARED_ELEMENT_HPP
+#define ORO_CHANNEL_SHARED_ELEMENT_HPP
+
+#include "../base/ChannelElement.hpp"
+#include "SharedConnection.hpp"
+
+namespace RTT { namespace internal {
+
+    /** A connection element that reads from a storage which is shared
+     * with the other shared connections of the same OutputPort.
+     * Each element has its own read cursor in the shared storage.
+     * @see ConnPolicy::shared
+     */
+    template<typename T>
+    class ChannelSharedElement : public base::ChannelElement<T>
+    {
+        typename SharedConnection<T>::shared_ptr storage;
+        typename SharedConnection<T>::Cursor* cursor;
+    public:
+        typedef typename base::ChannelElement<T>::param_t param_t;
+        typedef typename base::ChannelElement<T>::reference_t reference_t;
+
+        /**
+         * Attaches a new reader to a shared storage.
+         * @param storage The storage of the shared connections of the OutputPort.
+         * @param init If true, the last written sample (if any) will be read as NewData.
+         */
+        ChannelSharedElement(typename SharedConnection<T>::shared_ptr storage, bool init)
+            : storage(storage), cursor( storage->attach(init) ) {}
+
+        virtual ~ChannelSharedElement()
+        {
+            storage->detach(cursor);
+        }
+
+        /**
+         * Returns the storage shared with the other shared connections.
+         */
+        typename SharedConnection<T>::shared_ptr getSharedConnection() const
+        {
+            return storage;
+        }
+
+        /** Stores a sample in the shared storage and signals this
+         * connection. The OutputPort only calls this for one of its
+         * shared connections and signal() for all the others.
+         *
+         * @return true, also if the buffer was full.
+         */
+        virtual bool write(param_t sample)
+        {
+            if (storage->write(sample))
+                return this->signal();
+            return true;
+        }
+
+        /** Stores the samples in the shared storage and signals this
+         * connection once.
+         */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            bool written = false;
+            for (typename std::vector<T>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+                written = storage->write(*it) || written;
+            if (written)
+                return this->signal();
+            return true;
+        }
+
+        /** Reads the next sample of this connection from the shared storage.
+         */
+        virtual FlowStatus read(reference_t sample, bool copy_old_data)
+        {
+            return storage->read(cursor, sample, copy_old_data);
+        }
+
+        /** Returns the next sample of this connection in place.
+         */
+        virtual FlowStatus take(T const*& sample, reference_t buffer, bool copy_old_data)
+        {
+            return storage->take(cursor, sample);
+        }
+
+        /** Loans a sample from the shared storage. The sample is written
+         * for all shared connections by publish().
+         */
+        virtual T* loan(typename base::ChannelElement<T>::shared_ptr& owner)
+        {
+            T* sample = storage->loan();
+            if (sample)
+                owner = this;
+            return sample;
+        }
+
+        virtual bool publish()
+        {
+            return storage->publish();
+        }
+
+        /** Discards the samples this connection did not read yet. The other
+         * connections that share the storage are not affected.
+         */
+        virtual void clear()
+        {
+            storage->clear(cursor);
+            base::ChannelElement<T>::clear();
+        }
+
+        /** A disconnected element may be destroyed later than its
+         * connection is removed, so it stops holding back the writer now.
+         */
+        virtual void disconnect(bool forward)
+        {
+            storage->deactivate(cursor);
+            base::ChannelElement<T>::disconnect(forward);
+        }
+
+        /** The shared storage was allocated with the data sample of the
+         * OutputPort when the first shared connection was created.
+         */
+        virtual bool data_sample(param_t sample)
+        {
+            return base::ChannelElement<T>::data_sample(sample);
+        }
+
+        virtual T data_sample()
+        {
+            return storage->data_sample();
+        }
+    };
+}}
+
+#endif
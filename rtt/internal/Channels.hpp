@@ -41,6 +41,9 @@
 
 #include "ChannelDataElement.hpp"
 #include "ChannelBufferElement.hpp"
+#ifndef OROBLD_OS_NO_ASM
+#include "ChannelSharedElement.hpp"
+#endif
 
 #endif
 
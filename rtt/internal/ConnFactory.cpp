@@ -145,7 +145,10 @@ bool ConnFactory::createAndCheckStream(base::OutputPortInterface& output_port, C
     }
     chan->setOutput( chan_stream );
 
-    if ( output_port.addConnection( new StreamConnID(policy.name_id), chan, policy) ) {
+    // streams have their own storage, they are never shared.
+    ConnPolicy stream_policy = policy;
+    stream_policy.shared = false;
+    if ( output_port.addConnection( new StreamConnID(policy.name_id), chan, stream_policy) ) {
         log(Info) << "Created output stream for output port "<< output_port.getName() <<endlog();
         return true;
     }
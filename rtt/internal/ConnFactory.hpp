@@ -54,6 +54,9 @@
 #include "../base/BufferUnSync.hpp"
 #include "../Logger.hpp"
 
+#include <boost/type_traits/is_pod.hpp>
+#include <boost/mpl/bool.hpp>
+
 namespace RTT
 { namespace internal {
 
@@ -128,6 +131,29 @@ namespace RTT
          */
         virtual base::ChannelElementBase::shared_ptr buildChannelInput(base::OutputPortInterface& port) const = 0;
 
+#ifndef OROBLD_OS_NO_ASM
+        /**
+         * Small plain old data types are stored in a DataObjectSeqLock,
+         * since they can be copied while being written.
+         */
+        template<typename T>
+        struct UseSeqLock
+            : public boost::mpl::bool_< boost::is_pod<T>::value && sizeof(T) <= 256 >
+        {};
+
+        template<typename T>
+        static base::DataObjectInterface<T>* buildLockFreeDataObject(const T& initial_value, boost::mpl::true_)
+        {
+            return new base::DataObjectSeqLock<T>(initial_value);
+        }
+
+        template<typename T>
+        static base::DataObjectInterface<T>* buildLockFreeDataObject(const T& initial_value, boost::mpl::false_)
+        {
+            return new base::DataObjectLockFree<T>(initial_value);
+        }
+#endif
+
         /** This method creates the connection element that will store data
          * inside the connection, based on the given policy
          * @todo: shouldn't this belong in the template type info ? This allows the type lib to
@@ -145,7 +171,10 @@ namespace RTT
                 {
 #ifndef OROBLD_OS_NO_ASM
                 case ConnPolicy::LOCK_FREE:
-                    data_object.reset( new base::DataObjectLockFree<T>(initial_value) );
+                    if (policy.readers > 0)
+                        data_object.reset( new base::DataObjectWaitFree<T>(initial_value, policy.readers) );
+                    else
+                        data_object.reset( buildLockFreeDataObject(initial_value, typename UseSeqLock<T>::type()) );
                     break;
 #else
 		case ConnPolicy::LOCK_FREE:
@@ -261,6 +290,69 @@ namespace RTT
             return data_object;
         }
 
+        /**
+         * Variant of buildBufferedChannelOutput for shared connections.
+         * The storage is taken from the existing shared connections of
+         * \a output_port, or is created if there are none.
+         * @param output_port The output port to which the connection will be added.
+         * @param port The input port to which the connection is added.
+         * @param conn_id A unique connection id which identifies this connection
+         * @param policy The policy of the shared connection. It must
+         * be compatible with the other shared connections of \a output_port.
+         * @return The channel element that must be connected to the end
+         * of the input-half, or null if no compatible storage could be used.
+         */
+        template<typename T>
+        static base::ChannelElementBase::shared_ptr buildSharedChannelOutput(OutputPort<T>& output_port, InputPort<T>& port, ConnID* conn_id, ConnPolicy const& policy)
+        {
+            assert(conn_id);
+#ifndef OROBLD_OS_NO_ASM
+            typename SharedConnection<T>::shared_ptr storage = findSharedConnection(output_port);
+            if ( storage && !storage->isCompatible(policy) ) {
+                log(Error) << "Shared connections of port " << output_port.getName()
+                           << " use another type or size than requested for " << port.getName() << endlog();
+                delete conn_id;
+                return base::ChannelElementBase::shared_ptr();
+            }
+            if ( !storage ) {
+                storage.reset( new SharedConnection<T>(policy, output_port.getLastWrittenValue()) );
+                // The first reader initializes the storage with the last written value.
+                T last;
+                if ( policy.init && output_port.getLastWrittenValue(last) )
+                    storage->write(last);
+            }
+            base::ChannelElementBase::shared_ptr endpoint = new ConnOutputEndpoint<T>(&port, conn_id);
+            base::ChannelElementBase::shared_ptr data_object = new ChannelSharedElement<T>(storage, policy.init);
+            data_object->setOutput(endpoint);
+            return data_object;
+#else
+            log(Error) << "Shared connections are unavailable on this system." << endlog();
+            delete conn_id;
+            return base::ChannelElementBase::shared_ptr();
+#endif
+        }
+
+#ifndef OROBLD_OS_NO_ASM
+        /**
+         * Returns the storage of the shared connections of \a output_port,
+         * or null if it has none.
+         */
+        template<typename T>
+        static typename SharedConnection<T>::shared_ptr findSharedConnection(OutputPort<T>& output_port)
+        {
+            std::list<ConnectionManager::ChannelDescriptor> channels = output_port.getManager()->getChannels();
+            for (std::list<ConnectionManager::ChannelDescriptor>::iterator it = channels.begin(); it != channels.end(); ++it) {
+                if ( !it->get<2>().shared )
+                    continue;
+                base::ChannelElementBase::shared_ptr output = it->get<1>()->getOutput();
+                ChannelSharedElement<T>* shared = dynamic_cast<ChannelSharedElement<T>*>( output.get() );
+                if ( shared )
+                    return shared->getSharedConnection();
+            }
+            return typename SharedConnection<T>::shared_ptr();
+        }
+#endif
+
         /**
          * Creates a connection from a local output_port to a local or remote input_port.
          * This function contains all logic to decide on how connections must be created to
@@ -291,10 +383,23 @@ namespace RTT
                     return false;
                 }
                 // local ports, create buffer here.
-                output_half = buildBufferedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getLastWrittenValue());
+                if ( policy.shared )
+                    output_half = buildSharedChannelOutput<T>(output_port, *input_p, output_port.getPortID(), policy);
+                else
+                    output_half = buildBufferedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getLastWrittenValue());
             }
             else
             {
+                if ( policy.shared ) {
+                    log(Warning) << "Only local connections can be shared, the connection of " << output_port.getName()
+                                 << " to " << input_port.getName() << " will not be shared." << endlog();
+                    ConnPolicy unshared = policy;
+                    unshared.shared = false;
+                    bool result = createConnection(output_port, input_port, unshared);
+                    policy.name_id = unshared.name_id;
+                    policy.data_size = unshared.data_size;
+                    return result;
+                }
                 // if the input is not local, this is a pure remote connection,
                 // if the input *is* local, the user requested to use a different transport
                 // than plain memory, rare case, but we accept it. The unit tests use this for example
@@ -71,6 +71,15 @@ namespace RTT
         virtual FlowStatus read(typename base::ChannelElement<T>::reference_t sample)
         { return NoData; }
 
+        /** Forwards to the data storage, such that it can store the samples in one pass. */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            typename base::ChannelElement<T>::shared_ptr output = this->getOutput();
+            if (output)
+                return output->writeBatch(samples);
+            return false;
+        }
+
         virtual bool inputReady() {
             return true;
         }
@@ -128,6 +128,24 @@ namespace RTT
             return true;
         }
 
+        /** Forwards to the data storage, such that it can read the samples in one pass. */
+        virtual FlowStatus readAll(std::vector<T>& samples)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = this->getInput();
+            if (input)
+                return input->readAll(samples);
+            return NoData;
+        }
+
+        /** Forwards to the data storage, such that it can return the sample in place. */
+        virtual FlowStatus take(T const*& sample, typename base::ChannelElement<T>::reference_t buffer, bool copy_old_data)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = this->getInput();
+            if (input)
+                return input->take(sample, buffer, copy_old_data);
+            return NoData;
+        }
+
         virtual base::PortInterface* getPort() const {
             return this->port;
         }
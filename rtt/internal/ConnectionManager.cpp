@@ -59,7 +59,7 @@ namespace RTT
     {
 
         ConnectionManager::ConnectionManager(PortInterface* port)
-            : mport(port)
+            : mport(port), connections(0), cur_channel(0)
         {
         }
 
@@ -76,9 +76,31 @@ namespace RTT
             descriptor.get<1>()->clear();
         }
 
+        /**
+         * Helper function to copy a connection into a list.
+         */
+        void copyChannel(std::list<ConnectionManager::ChannelDescriptor>* result, ConnectionManager::ChannelDescriptor& descriptor) {
+            result->push_back(descriptor);
+        }
+
+        /**
+         * Helper function to find a connection by its channel.
+         */
+        bool isChannel(ChannelElementBase* channel, ConnectionManager::ChannelDescriptor const& descriptor) {
+            return descriptor.get<1>().get() == channel;
+        }
+
+        /**
+         * Helper function to look up the channel of getCurrentChannel().
+         */
+        void getChannel(ChannelElementBase* channel, ChannelElementBase::shared_ptr* result, ConnectionManager::ChannelDescriptor& descriptor) {
+            if ( descriptor.get<1>().get() == channel )
+                *result = descriptor.get<1>();
+        }
+
         void ConnectionManager::clear()
-        { RTT::os::MutexLock lock(connection_lock);
-            std::for_each(connections.begin(), connections.end(), &clearChannel);
+        {
+            connections.apply( &clearChannel );
         }
 
         bool ConnectionManager::findMatchingPort(ConnID const* conn_id, ChannelDescriptor const& descriptor)
@@ -89,9 +111,25 @@ namespace RTT
         void ConnectionManager::updateCurrentChannel(bool reset_current)
         {
             if (connections.empty())
-                cur_channel = ChannelDescriptor();
+                cur_channel = 0;
             else if (reset_current)
-                cur_channel = connections.front();
+                cur_channel = connections.front().get<1>().get();
+        }
+
+        ChannelElementBase::shared_ptr ConnectionManager::getCurrentChannel() const
+        {
+            ChannelElementBase::shared_ptr result;
+            ChannelElementBase* channel = cur_channel;
+            if ( channel )
+                connections.apply( boost::bind(&getChannel, channel, &result, _1) );
+            return result;
+        }
+
+        std::list<ConnectionManager::ChannelDescriptor> ConnectionManager::getChannels() const
+        {
+            std::list<ChannelDescriptor> result;
+            connections.apply( boost::bind(&copyChannel, &result, _1) );
+            return result;
         }
 
         bool ConnectionManager::disconnect(PortInterface* port)
@@ -115,8 +153,11 @@ namespace RTT
         {
             std::list<ChannelDescriptor> all_connections;
             { RTT::os::MutexLock lock(connection_lock);
-                all_connections.splice(all_connections.end(), connections);
-                cur_channel = ChannelDescriptor();
+                connections.apply( boost::bind(&copyChannel, &all_connections, _1) );
+                connections.clear();
+                connections.shrink( all_connections.size() );
+                connections.release_unused();
+                cur_channel = 0;
             }
             std::for_each(all_connections.begin(), all_connections.end(),
                     boost::bind(&ConnectionManager::eraseConnection, this, _1));
@@ -130,23 +171,28 @@ namespace RTT
         { RTT::os::MutexLock lock(connection_lock);
             assert(conn_id);
             ChannelDescriptor descriptor = boost::make_tuple(conn_id, channel, policy);
-            if (connections.empty())
-                cur_channel = descriptor;
-            connections.push_back(descriptor);
+            connections.grow(1);
+            connections.append(descriptor);
+            if (cur_channel == 0)
+                cur_channel = channel.get();
+        }
+
+        bool ConnectionManager::removeChannel(ChannelElementBase* channel)
+        { RTT::os::MutexLock lock(connection_lock);
+            if ( !connections.delete_if( boost::bind(&isChannel, channel, _1) ) )
+                return false;
+            connections.shrink(1);
+            connections.release_unused();
+            updateCurrentChannel( cur_channel == channel );
+            return true;
         }
 
         bool ConnectionManager::removeConnection(ConnID* conn_id)
         {
-            ChannelDescriptor descriptor;
-            { RTT::os::MutexLock lock(connection_lock);
-                std::list<ChannelDescriptor>::iterator conn_it =
-                    std::find_if(connections.begin(), connections.end(), boost::bind(&ConnectionManager::findMatchingPort, this, conn_id, _1));
-                if (conn_it == connections.end())
-                    return false;
-                descriptor = *conn_it;
-                connections.erase(conn_it);
-                updateCurrentChannel( cur_channel.get<1>() == descriptor.get<1>() );
-            }
+            ChannelDescriptor descriptor = connections.find_if( boost::bind(&ConnectionManager::findMatchingPort, this, conn_id, _1) );
+            // removeChannel() fails if a concurrent call already removed it.
+            if ( !descriptor.get<1>() || !removeChannel( descriptor.get<1>().get() ) )
+                return false;
 
             // disconnect needs to know if we're from Out->In (forward) or from In->Out
             bool is_forward = true;
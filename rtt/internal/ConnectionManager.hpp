@@ -63,6 +63,7 @@
 #include <rtt/os/Mutex.hpp>
 #include <rtt/os/MutexLock.hpp>
 #include <list>
+#include <vector>
 
 
 namespace RTT
@@ -74,7 +75,12 @@ namespace RTT
          * Manages connections between ports.
          * This class is used for input and output ports
          * in order to manage their channels.
-         * TODO: use the mutex lock !!!
+         *
+         * The connections are stored in a lock-free list, such that
+         * reading and writing the port (select_reader_channel() and delete_if())
+         * never blocks on a thread which is adding or removing a connection.
+         * Adding and removing connections is serialized with a mutex and
+         * may allocate memory.
          */
         class RTT_API ConnectionManager
         {
@@ -117,21 +123,21 @@ namespace RTT
             /** Removes the channel that connects this port to \c port */
             bool disconnect(base::PortInterface* port);
 
+            /**
+             * Removes all connections for which pred(connection) is true.
+             * The removed channels are not disconnected.
+             * This function does not lock and only allocates
+             * memory if a channel is removed.
+             * @param pred
+             * @return true if at least one connection was removed.
+             */
             template<typename Pred>
             bool delete_if(Pred pred) {
-                RTT::os::MutexLock lock(connection_lock);
-                bool result = false;
-                std::list<ChannelDescriptor>::iterator it = connections.begin();
-                while (it != connections.end())
-                {
-                    if (pred(*it))
-                    {
-                        result = true;
-                        it = connections.erase(it);
-                    }
-                    else ++it;
-                }
-                return result;
+                std::vector<base::ChannelElementBase*> failed;
+                connections.apply( ApplyPredicate<Pred>(pred, failed) );
+                for (std::vector<base::ChannelElementBase*>::iterator it = failed.begin(); it != failed.end(); ++it)
+                    removeChannel(*it);
+                return !failed.empty();
             }
 
             /**
@@ -140,37 +146,39 @@ namespace RTT
              * the current channel ( getCurrentChannel() ), if that
              * does not satisfy pred, iterate over \b all connections.
              * If none satisfy pred, the current channel remains unchanged.
+             * This function does not lock nor allocate memory.
              * @param pred
              */
             template<typename Pred>
             void select_reader_channel(Pred pred, bool copy_old_data) {
-                RTT::os::MutexLock lock(connection_lock);
-                std::pair<bool, ChannelDescriptor> new_channel =
-                    find_if(pred, copy_old_data);
-                if (new_channel.first)
+                base::ChannelElementBase* new_channel = find_if(pred, copy_old_data);
+                if (new_channel)
                 {
                     // We don't clear the current channel (to get it to NoData state), because there is a race
                     // between find_if and this line. We have to accept (in other parts of the code) that eventually,
                     // all channels return 'OldData'.
-                    cur_channel = new_channel.second;
+                    cur_channel = new_channel;
                 }
             }
 
+            /**
+             * Returns the first channel for which pred(copy_old_data, connection)
+             * is true, starting with the current channel. The other channels
+             * are only checked with copy_old_data set to false.
+             * @return null if pred was true for none of the connections.
+             */
             template<typename Pred>
-            std::pair<bool, ChannelDescriptor> find_if(Pred pred, bool copy_old_data) {
+            base::ChannelElementBase* find_if(Pred pred, bool copy_old_data) {
                 // We only copy OldData in the initial read of the current channel.
                 // if it has no new data, the search over the other channels starts,
                 // but no old data is needed.
-                ChannelDescriptor channel = cur_channel;
-                if ( channel.get<1>() )
-                    if ( pred( copy_old_data, channel ) )
-                        return std::make_pair(true, channel);
-
-                std::list<ChannelDescriptor>::iterator result;
-                for (result = connections.begin(); result != connections.end(); ++result)
-                    if ( pred(false, *result) == true)
-                        return std::make_pair(true, *result);
-                return std::make_pair(false, ChannelDescriptor());
+                base::ChannelElementBase* channel = cur_channel;
+                base::ChannelElementBase* result = 0;
+                if ( channel )
+                    connections.apply( SelectChannel<Pred>(pred, copy_old_data, channel, result) );
+                if ( !result )
+                    connections.apply( SelectChannel<Pred>(pred, false, 0, result) );
+                return result;
             }
 
             /**
@@ -184,16 +192,13 @@ namespace RTT
              * @see select_if to change the current channel.
              * @return
              */
-            base::ChannelElementBase* getCurrentChannel() const {
-                return cur_channel.get<1>().get();
-            }
+            base::ChannelElementBase::shared_ptr getCurrentChannel() const;
 
             /**
              * Returns a list of all channels managed by this object.
+             * @note Not real-time.
              */
-            std::list<ChannelDescriptor> getChannels() const {
-                return connections;
-            }
+            std::list<ChannelDescriptor> getChannels() const;
 
             /**
              * Clears (removes) all data in the manager's connections.
@@ -203,6 +208,47 @@ namespace RTT
             void clear();
 
         protected:
+            /**
+             * Calls a delete_if() predicate and remembers the channels
+             * for which it returned true.
+             */
+            template<typename Pred>
+            struct ApplyPredicate {
+                Pred& pred;
+                std::vector<base::ChannelElementBase*>& failed;
+                ApplyPredicate(Pred& pred, std::vector<base::ChannelElementBase*>& failed)
+                    : pred(pred), failed(failed) {}
+                void operator()(ChannelDescriptor& descriptor) {
+                    if ( pred(descriptor) )
+                        failed.push_back( descriptor.get<1>().get() );
+                }
+            };
+
+            /**
+             * Calls a select_reader_channel() predicate until it returns true.
+             * If \a only is set, only that channel is checked.
+             */
+            template<typename Pred>
+            struct SelectChannel {
+                Pred& pred;
+                bool copy_old_data;
+                base::ChannelElementBase* only;
+                base::ChannelElementBase*& result;
+                SelectChannel(Pred& pred, bool copy_old_data, base::ChannelElementBase* only, base::ChannelElementBase*& result)
+                    : pred(pred), copy_old_data(copy_old_data), only(only), result(result) {}
+                void operator()(ChannelDescriptor& descriptor) {
+                    base::ChannelElementBase* channel = descriptor.get<1>().get();
+                    if ( result || (only && channel != only) )
+                        return;
+                    if ( pred(copy_old_data, descriptor) )
+                        result = channel;
+                }
+            };
+
+            /**
+             * Removes the connection of \a channel without disconnecting it.
+             */
+            bool removeChannel(base::ChannelElementBase* channel);
 
             void updateCurrentChannel(bool reset_current);
 
@@ -231,19 +277,19 @@ namespace RTT
             base::PortInterface* mport;
 
             /**
-             * A list of all our connections. Only non-null if two or more connections
-             * were added.
+             * A lock-free list of all our connections.
              */
-            std::list< ChannelDescriptor > connections;
+            mutable List< ChannelDescriptor > connections;
 
             /**
-             * Optimisation in case only one channel is to be managed.
+             * The channel that was last read from. It is only used to
+             * identify an element of \a connections and is never dereferenced.
              */
-            ChannelDescriptor cur_channel;
+            base::ChannelElementBase* volatile cur_channel;
 
             /**
              * Lock that should be taken before the list of connections is
-             * accessed or modified
+             * modified. It is not taken for reading or writing the channels.
              */
             RTT::os::Mutex connection_lock;
         };
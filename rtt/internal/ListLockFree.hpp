@@ -332,6 +332,24 @@ namespace RTT
             oro_atomic_dec( &orig->count ); // ref count
         }
 
+        /**
+         * Destroys the copies of removed elements which are still kept
+         * in the unused buffers of this list. Elements are otherwise only
+         * destroyed when their buffer is used again by a next modification.
+         * @note This function is only real-time if the destructor of
+         * of \a T is real-time.
+         */
+        void release_unused()
+        {
+            Storage st = bufs;
+            for (unsigned int i=0; i < BufNum(); ++i) {
+                Item& item = (*st)[i];
+                if ( oro_atomic_inc_and_test( &item.count ) )
+                    item.data.clear();
+                oro_atomic_dec( &item.count );
+            }
+        }
+
         /**
          * Append a single value to the list.
          * This function calls the copy-constructor of \a item and may call
@@ -174,6 +174,22 @@ namespace RTT
             mlist.clear_and_dispose( boost::bind(&ListLocked::give_back, this, _1) );
         }
 
+        /**
+         * Destroys the copies of removed elements which are still kept
+         * in the reserved storage of this list.
+         */
+        void release_unused()
+        {
+            os::MutexLock lock(m);
+            StackType reserved;
+            while ( !mreserved.empty() ) {
+                mreserved.top()->data = T();
+                reserved.push( mreserved.top() );
+                mreserved.pop();
+            }
+            mreserved = reserved;
+        }
+
         /**
          * Append a single value to the list.
          * @param d the value to write
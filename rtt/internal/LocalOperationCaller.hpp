@@ -53,6 +53,7 @@
 #include "OperationCallerBinder.hpp"
 #include <boost/fusion/include/vector_tie.hpp>
 #include "../os/oro_allocator.hpp"
+#include "CallPool.hpp"
 
 #include <iostream>
 // For doing I/O
@@ -129,6 +130,8 @@ namespace RTT
 
             SendHandle<Signature> do_send(shared_ptr cl) {
                 //std::cout << "Sending clone..."<<std::endl;
+                if ( !cl )
+                    return SendHandle<Signature>(); // all pending calls in use.
                 ExecutionEngine* receiver = this->getMessageProcessor();
                 cl->self = cl;
                 if ( receiver && receiver->process( cl.get() ) ) {
@@ -148,6 +151,8 @@ namespace RTT
             SendHandle<Signature> send_impl( T1 a1 ) {
                 // bind types from Storage<Function>
                 shared_ptr cl = this->cloneRT();
+                if ( !cl )
+                    return SendHandle<Signature>();
                 cl->store( a1 );
                 return do_send(cl);
             }
@@ -156,6 +161,8 @@ namespace RTT
             SendHandle<Signature> send_impl( T1 a1, T2 a2 ) {
                 // bind types from Storage<Function>
                 shared_ptr cl = this->cloneRT();
+                if ( !cl )
+                    return SendHandle<Signature>();
                 cl->store( a1,a2 );
                 return do_send(cl);
             }
@@ -164,6 +171,8 @@ namespace RTT
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3 ) {
                 // bind types from Storage<Function>
                 shared_ptr cl = this->cloneRT();
+                if ( !cl )
+                    return SendHandle<Signature>();
                 cl->store( a1,a2,a3 );
                 return do_send(cl);
             }
@@ -172,6 +181,8 @@ namespace RTT
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4 ) {
                 // bind types from Storage<Function>
                 shared_ptr cl = this->cloneRT();
+                if ( !cl )
+                    return SendHandle<Signature>();
                 cl->store( a1,a2,a3,a4 );
                 return do_send(cl);
             }
@@ -180,6 +191,8 @@ namespace RTT
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4, T5 a5 ) {
                 // bind types from Storage<Function>
                 shared_ptr cl = this->cloneRT();
+                if ( !cl )
+                    return SendHandle<Signature>();
                 cl->store( a1,a2,a3,a4,a5 );
                 return do_send(cl);
             }
@@ -188,6 +201,8 @@ namespace RTT
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6 ) {
                 // bind types from Storage<Function>
                 shared_ptr cl = this->cloneRT();
+                if ( !cl )
+                    return SendHandle<Signature>();
                 cl->store( a1,a2,a3,a4,a5,a6 );
                 return do_send(cl);
             }
@@ -196,6 +211,8 @@ namespace RTT
             SendHandle<Signature> send_impl( T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7 ) {
                 // bind types from Storage<Function>
                 shared_ptr cl = this->cloneRT();
+                if ( !cl )
+                    return SendHandle<Signature>();
                 cl->store( a1,a2,a3,a4,a5,a6,a7 );
                 return do_send(cl);
             }
@@ -616,7 +633,39 @@ namespace RTT
             }
 
             virtual shared_ptr cloneRT() const = 0;
+
+            /**
+             * Stores at most \a n asynchronous calls of this object and
+             * of its copies in a pool, which is allocated here. A send()
+             * then takes a slot without locking and fails with SendFailure
+             * when all are in use. If \a n is zero, send() uses the
+             * real-time allocator again.
+             */
+            void setMaxPendingCalls(unsigned int n) {
+                if ( n == 0 ) {
+                    mpool.reset();
+                    return;
+                }
+                // let boost tell how large one call and its reference count are.
+                std::size_t size = 0;
+                mpool.reset();
+                this->cloneSized(&size);
+                mpool.reset( new CallPool(n, size) );
+            }
+
+            /**
+             * Returns the number of pending calls set with setMaxPendingCalls().
+             */
+            unsigned int getMaxPendingCalls() const {
+                return mpool ? mpool->capacity() : 0;
+            }
         protected:
+            /**
+             * Clones this object with a measuring CallPoolAllocator, in order to
+             * find the size of a CallPool block.
+             */
+            virtual void cloneSized(std::size_t* size) const = 0;
+
             typedef BindStorage<FunctionT> Store;
             /**
              * Used to refcount self as long as dispose() is not called.
@@ -624,6 +673,10 @@ namespace RTT
              * were allocated with the rt_allocator class.
              */
             typename base::OperationCallerBase<FunctionT>::shared_ptr self;
+            /**
+             * Holds the clones made by cloneRT(), if setMaxPendingCalls() was used.
+             */
+            CallPool::shared_ptr mpool;
         };
 
         /**
@@ -704,9 +757,20 @@ namespace RTT
 
             typename LocalOperationCallerImpl<Signature>::shared_ptr cloneRT() const
             {
+                if ( this->mpool ) {
+                    void* block = this->mpool->allocate();
+                    if ( !block )
+                        return typename LocalOperationCallerImpl<Signature>::shared_ptr();
+                    return boost::allocate_shared<LocalOperationCaller<Signature> >(CallPoolAllocator<LocalOperationCaller<Signature> >(this->mpool, block), *this);
+                }
                 // returns identical copy of this;
                 return boost::allocate_shared<LocalOperationCaller<Signature> >(os::rt_allocator<LocalOperationCaller<Signature> >(), *this);
             }
+        protected:
+            void cloneSized(std::size_t* size) const
+            {
+                boost::allocate_shared<LocalOperationCaller<Signature> >(CallPoolAllocator<LocalOperationCaller<Signature> >(size), *this);
+            }
         };
     }
 }
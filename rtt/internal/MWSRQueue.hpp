@@ -50,7 +50,7 @@
 #if defined(OROBLD_OS_NO_ASM)
 #include "LockedQueue.hpp"
 #else
-#include "AtomicMWSRQueue.hpp"
+#include "SegmentedMWSRQueue.hpp"
 #endif
 
 namespace RTT
@@ -67,18 +67,22 @@ namespace RTT
 #if defined(OROBLD_OS_NO_ASM)
                 : public LockedQueue<T>
 #else
-                : public AtomicMWSRQueue<T>
+                : public SegmentedMWSRQueue<T>
 #endif
         {
         public:
             /**
-             * Create a mw/sr queue of fixed size.
+             * Create a mw/sr queue of \a qsize elements.
+             * @param growable If true, the queue grows with segments of a
+             * pool which is shared by all growable queues of \a T, instead
+             * of refusing elements when it is full. This option has no effect
+             * when the lock-free algorithms are not available on this system.
              */
-            MWSRQueue(int qsize)
+            MWSRQueue(int qsize, bool growable = false)
 #if defined(OROBLD_OS_NO_ASM)
             : LockedQueue<T>(qsize)
 #else
-            : AtomicMWSRQueue<T> (qsize)
+            : SegmentedMWSRQueue<T> (qsize, growable ? SegmentedMWSRQueue<T>::SegmentPool::Instance() : boost::shared_ptr<typename SegmentedMWSRQueue<T>::SegmentPool>() )
 #endif
             {
             }
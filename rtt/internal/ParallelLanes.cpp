@@ -0,0 +1,122 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ParallelLanes.cpp
+
+                        ParallelLanes.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ParallelLanes.hpp"
+#include "../os/Thread.hpp"
+#include "../os/MutexLock.hpp"
+
+#include <sstream>
+
+namespace RTT {
+    using namespace internal;
+
+    /**
+     * Executes one lane each time it is started.
+     */
+    class ParallelLanes::Helper
+        : public os::Thread
+    {
+        ParallelLanes* mowner;
+        unsigned int mnumber;
+    public:
+        Helper(ParallelLanes* owner, unsigned int number, int scheduler, int priority,
+               unsigned cpu_affinity, const std::string& name)
+            : Thread(scheduler, priority, 0.0, cpu_affinity, name),
+              mowner(owner), mnumber(number)
+        {}
+
+        void loop() {
+            mowner->mlane(mnumber);
+            mowner->done();
+        }
+    };
+
+    ParallelLanes::ParallelLanes(const LaneFunction& lane, int scheduler, int priority,
+                                 const std::vector<unsigned>& cpu_affinities, const std::string& name)
+        : mlane(lane), mpending(0)
+    {
+        for (unsigned int i = 0; i != cpu_affinities.size(); ++i) {
+            std::stringstream helper_name;
+            helper_name << name << i + 1;
+            mhelpers.push_back( new Helper(this, i + 1, scheduler, priority, cpu_affinities[i], helper_name.str()) );
+        }
+    }
+
+    ParallelLanes::~ParallelLanes()
+    {
+        for (unsigned int i = 0; i != mhelpers.size(); ++i) {
+            mhelpers[i]->stop();
+            delete mhelpers[i];
+        }
+    }
+
+    unsigned int ParallelLanes::getLanes() const
+    {
+        return mhelpers.size() + 1;
+    }
+
+    void ParallelLanes::run()
+    {
+        if ( !mhelpers.empty() ) {
+            {
+                os::MutexLock lock(mlock);
+                mpending = mhelpers.size();
+            }
+            for (unsigned int i = 0; i != mhelpers.size(); ++i)
+                mhelpers[i]->start();
+        }
+        mlane(0);
+        if ( !mhelpers.empty() ) {
+            os::MutexLock lock(mlock);
+            while ( mpending != 0 )
+                mdone.wait(mlock);
+        }
+    }
+
+    void ParallelLanes::stop()
+    {
+        for (unsigned int i = 0; i != mhelpers.size(); ++i)
+            mhelpers[i]->stop();
+    }
+
+    void ParallelLanes::done()
+    {
+        os::MutexLock lock(mlock);
+        if ( --mpending == 0 )
+            mdone.broadcast();
+    }
+}
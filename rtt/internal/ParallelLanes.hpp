@@ -0,0 +1,122 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ParallelLanes.hpp
+
+                        ParallelLanes.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_PARALLEL_LANES_HPP
+#define ORO_PARALLEL_LANES_HPP
+
+#include "../os/Mutex.hpp"
+#include "../os/Condition.hpp"
+#include "../rtt-config.h"
+#include <vector>
+#include <string>
+#include <boost/function.hpp>
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * Executes a piece of work divided over a number of lanes in
+     * parallel, and waits until all lanes are done (fork/join).
+     *
+     * Lane 0 is executed by the thread calling run(), the other lanes
+     * each by their own helper thread. The helper threads are
+     * non-periodic threads which are started again for each run().
+     */
+    class RTT_API ParallelLanes
+    {
+    public:
+        /**
+         * The function executing one lane, which receives the lane number.
+         */
+        typedef boost::function<void(unsigned int)> LaneFunction;
+
+        /**
+         * Creates one helper thread for each element of \a cpu_affinities.
+         *
+         * @param lane The function executing a lane.
+         * @param scheduler The scheduler of the helper threads.
+         * @param priority The priority of the helper threads.
+         * @param cpu_affinities The cpu affinity of each helper thread.
+         * @param name The name of the helper threads, which is followed
+         * by their lane number.
+         */
+        ParallelLanes(const LaneFunction& lane, int scheduler, int priority,
+                      const std::vector<unsigned>& cpu_affinities, const std::string& name);
+
+        /**
+         * Stops and destroys the helper threads.
+         * @pre run() is not executing.
+         */
+        ~ParallelLanes();
+
+        /**
+         * Returns the number of lanes, which is the number of
+         * helper threads plus one.
+         */
+        unsigned int getLanes() const;
+
+        /**
+         * Executes all lanes and returns when they are all done.
+         */
+        void run();
+
+        /**
+         * Stops the helper threads. They are started again by the next run().
+         */
+        void stop();
+
+    private:
+        ParallelLanes(const ParallelLanes&);
+
+        class Helper;
+        friend class Helper;
+
+        /**
+         * Called by a helper when it finished its lane.
+         */
+        void done();
+
+        LaneFunction mlane;
+        std::vector<Helper*> mhelpers;
+        os::Mutex mlock;
+        os::Condition mdone;
+        unsigned int mpending;
+    };
+
+}}
+
+#endif
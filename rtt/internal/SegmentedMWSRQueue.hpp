@@ -0,0 +1,369 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  SegmentedMWSRQueue.hpp
+
+                        SegmentedMWSRQueue.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SEGMENTED_MWSR_QUEUE_HPP
+#define ORO_SEGMENTED_MWSR_QUEUE_HPP
+
+#include "../rtt-config.h"
+#include "../os/CAS.hpp"
+#include "AtomicMWSRQueue.hpp"
+#include "AtomicQueue.hpp"
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+/**
+ * The number of segments in the pool shared by all growable queues
+ * of the same element type.
+ */
+#ifndef ORONUM_MWSR_QUEUE_SEGMENTS
+#define ORONUM_MWSR_QUEUE_SEGMENTS 32
+#endif
+
+/**
+ * The number of elements of each segment in the shared pool.
+ */
+#ifndef ORONUM_MWSR_QUEUE_SEGMENT_SIZE
+#define ORONUM_MWSR_QUEUE_SEGMENT_SIZE 64
+#endif
+
+namespace RTT
+{
+    namespace internal
+    {
+        /**
+         * A Multi-Writer Single-Reader FIFO of pointers, which optionally
+         * grows when it is full.
+         *
+         * The queue starts with one segment of its own, an AtomicMWSRQueue.
+         * If a SegmentPool is given and the last segment is full, a writer
+         * appends a segment from the pool, which the reader returns to the
+         * pool once it emptied it. The pool is allocated in advance and may
+         * be shared by many queues, hence growing does not allocate memory
+         * and is lock-free. enqueue() only fails when the pool is exhausted.
+         * A drained segment which is the last of the queue is only returned
+         * when the queue grows again or when the queue is destroyed.
+         *
+         * Without a pool, this queue is an AtomicMWSRQueue of fixed size.
+         * @warning You can not store null pointers.
+         * @param T The pointer type to be stored in the Queue.
+         * @ingroup CoreLibBuffers
+         */
+        template<class T>
+        class SegmentedMWSRQueue
+        {
+        public:
+            typedef unsigned int size_type;
+
+            /**
+             * A part of the queue.
+             */
+            struct Segment
+            {
+                AtomicMWSRQueue<T> queue;
+                Segment* volatile next;
+                /**
+                 * The number of writers which may enqueue in this segment.
+                 * The reader only leaves a segment without writers.
+                 */
+                oro_atomic_t writers;
+
+                explicit Segment(size_type size)
+                    : queue(size), next(0)
+                {
+                    oro_atomic_set(&writers, 0);
+                }
+            };
+
+            /**
+             * A preallocated set of segments, which may be shared by many queues.
+             */
+            class SegmentPool
+            {
+                std::vector<Segment*> segments;
+                /**
+                 * Twice as large as needed, since an AtomicQueue
+                 * may report full before it reached its capacity.
+                 */
+                AtomicQueue<Segment*> free;
+
+                SegmentPool(const SegmentPool&);
+            public:
+                /**
+                 * Allocates \a count segments of \a segment_size elements.
+                 */
+                SegmentPool(unsigned int count, size_type segment_size)
+                    : free(2 * count)
+                {
+                    for (unsigned int i = 0; i != count; ++i) {
+                        segments.push_back( new Segment(segment_size) );
+                        free.enqueue( segments.back() );
+                    }
+                }
+
+                ~SegmentPool()
+                {
+                    for (unsigned int i = 0; i != segments.size(); ++i)
+                        delete segments[i];
+                }
+
+                /**
+                 * Takes an empty segment from the pool.
+                 * @return null if the pool is exhausted.
+                 */
+                Segment* allocate()
+                {
+                    Segment* result = 0;
+                    free.dequeue(result);
+                    return result;
+                }
+
+                /**
+                 * Returns an empty segment to the pool.
+                 */
+                void deallocate(Segment* segment)
+                {
+                    segment->next = 0;
+                    free.enqueue(segment);
+                }
+
+                /**
+                 * The pool which is shared by all growable queues of \a T.
+                 * It holds ORONUM_MWSR_QUEUE_SEGMENTS segments of
+                 * ORONUM_MWSR_QUEUE_SEGMENT_SIZE elements and is
+                 * created on first use.
+                 */
+                static boost::shared_ptr<SegmentPool> Instance()
+                {
+                    static boost::shared_ptr<SegmentPool> instance( new SegmentPool(ORONUM_MWSR_QUEUE_SEGMENTS, ORONUM_MWSR_QUEUE_SEGMENT_SIZE) );
+                    return instance;
+                }
+            };
+
+        private:
+            /**
+             * The segment of this queue. It is either in the chain
+             * from head to tail, or it is the spare segment.
+             */
+            Segment* own;
+            /**
+             * Our own segment, when it is not in use.
+             */
+            Segment* volatile spare;
+            /**
+             * The segment to read from. Only the reader modifies it.
+             */
+            Segment* head;
+            /**
+             * The segment to write to.
+             */
+            Segment* volatile tail;
+            boost::shared_ptr<SegmentPool> pool;
+
+            // non-copyable !
+            SegmentedMWSRQueue(const SegmentedMWSRQueue<T>&);
+
+            Segment* takeSegment()
+            {
+                Segment* result = spare;
+                if ( result && os::CAS(&spare, result, (Segment*)0) )
+                    return result;
+                return pool->allocate();
+            }
+
+            void returnSegment(Segment* segment)
+            {
+                if ( segment == own ) {
+                    segment->next = 0;
+                    spare = segment;
+                } else
+                    pool->deallocate(segment);
+            }
+
+        public:
+            /**
+             * Create a queue with room for \a size elements, which grows
+             * with segments of \a pool when it is full.
+             * @param size The size of the queue, should be 1 or greater.
+             * @param pool The pool to take segments from. If null,
+             * the queue does not grow.
+             */
+            SegmentedMWSRQueue(size_type size, boost::shared_ptr<SegmentPool> pool = boost::shared_ptr<SegmentPool>())
+                : own( new Segment(size) ), spare(0), head(own), tail(own), pool(pool)
+            {
+            }
+
+            ~SegmentedMWSRQueue()
+            {
+                Segment* segment = head;
+                while ( segment ) {
+                    Segment* next = segment->next;
+                    if ( segment != own ) {
+                        segment->queue.clear();
+                        pool->deallocate(segment);
+                    }
+                    segment = next;
+                }
+                delete own;
+            }
+
+            /**
+             * Returns true if this queue grows when it is full.
+             */
+            bool isGrowable() const
+            {
+                return pool.get() != 0;
+            }
+
+            /**
+             * Inspect if the Queue is full. A growable queue is never full,
+             * but enqueue() may still fail if the pool is exhausted.
+             */
+            bool isFull() const
+            {
+                return !pool && own->queue.isFull();
+            }
+
+            /**
+             * Inspect if the Queue is empty.
+             * Only the reader may call this function.
+             */
+            bool isEmpty() const
+            {
+                for (Segment* segment = head; segment; segment = segment->next)
+                    if ( !segment->queue.isEmpty() )
+                        return false;
+                return true;
+            }
+
+            /**
+             * Return the number of elements this queue can contain
+             * without growing.
+             */
+            size_type capacity() const
+            {
+                return own->queue.capacity();
+            }
+
+            /**
+             * Return the number of elements in the queue.
+             * Only the reader may call this function.
+             */
+            size_type size() const
+            {
+                size_type result = 0;
+                for (Segment* segment = head; segment; segment = segment->next)
+                    result += segment->queue.size();
+                return result;
+            }
+
+            /**
+             * Enqueue an item.
+             * @param value The value to enqueue.
+             * @return false if queue is full and can not grow, true if queued.
+             */
+            bool enqueue(const T& value)
+            {
+                if ( !pool )
+                    return own->queue.enqueue(value);
+                while ( true ) {
+                    Segment* segment = tail;
+                    oro_atomic_inc(&segment->writers);
+                    // the reader may have left this segment already.
+                    if ( segment != tail ) {
+                        oro_atomic_dec(&segment->writers);
+                        continue;
+                    }
+                    if ( segment->queue.enqueue(value) ) {
+                        oro_atomic_dec(&segment->writers);
+                        return true;
+                    }
+                    // full: append a segment, unless another writer did.
+                    if ( segment->next == 0 ) {
+                        Segment* next = takeSegment();
+                        if ( next == 0 ) {
+                            oro_atomic_dec(&segment->writers);
+                            return false;
+                        }
+                        if ( !os::CAS(&segment->next, (Segment*)0, next) )
+                            returnSegment(next);
+                    }
+                    os::CAS(&tail, segment, segment->next);
+                    oro_atomic_dec(&segment->writers);
+                }
+            }
+
+            /**
+             * Dequeue an item.
+             * Only one thread may call this function.
+             * @param result Stores the dequeued value. It is unchanged when
+             * dequeue returns false and contains the dequeued value
+             * when it returns true.
+             * @return false if queue is empty, true if result was written.
+             */
+            bool dequeue(T& result)
+            {
+                if ( !pool )
+                    return own->queue.dequeue(result);
+                while ( true ) {
+                    Segment* segment = head;
+                    if ( segment->queue.dequeue(result) )
+                        return true;
+                    Segment* next = segment->next;
+                    if ( next == 0 || oro_atomic_read(&segment->writers) != 0 )
+                        return false;
+                    // a writer may have enqueued before it left this segment.
+                    if ( segment->queue.dequeue(result) )
+                        return true;
+                    head = next;
+                    returnSegment(segment);
+                }
+            }
+
+            /**
+             * Clear all contents of the Queue and thus make it empty.
+             * Only the reader may call this function.
+             */
+            void clear()
+            {
+                T item;
+                while ( dequeue(item) ) {}
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,440 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  SharedConnection.hpp
+
+                        SharedConnection.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SHARED_CONNECTION_HPP
+#define ORO_SHARED_CONNECTION_HPP
+
+#include "../os/oro_arch.h"
+#include "../os/CAS.hpp"
+#include "../ConnPolicy.hpp"
+#include "../FlowStatus.hpp"
+#include <boost/shared_ptr.hpp>
+#include <boost/call_traits.hpp>
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * The data storage of a shared connection. All shared connections
+     * of one OutputPort use one such object, such that each sample is
+     * copied only once into the connection, independent of the number
+     * of readers.
+     *
+     * The storage is a ring of \a size samples, rounded up to a power of
+     * two, indexed by a sequence number which is incremented on each write.
+     * The power of two keeps the slot of a sequence number the same when
+     * the sequence number wraps. Each reader owns a
+     * Cursor which holds the sequence number of the next sample to read.
+     * A DATA connection is a ring of size one, of which each reader
+     * always reads the newest sample.
+     *
+     * The samples are stored in a pool of buffers which are protected by
+     * a reader counter, like in base::DataObjectLockFree. The writer only
+     * writes into buffers which are neither in the ring nor being read.
+     * A reader keeps its last read buffer locked, such that it can return
+     * OldData without copying. The pool therefore holds one buffer per
+     * ring slot + 1 + 2 buffers per reader, and grows when a reader is
+     * attached. One more buffer
+     * allows the writer to loan() a sample, fill it in and publish() it
+     * without copying it.
+     *
+     * There may be only one writer (the OutputPort) and each Cursor must only
+     * be used by one thread at a time (its InputPort). Attaching and detaching
+     * readers may happen concurrently with reads and writes, but may allocate
+     * memory.
+     *
+     * When the ring is full, a BUFFER connection drops the new sample, as long
+     * as the slowest reader did not read the oldest one. A CIRCULAR_BUFFER
+     * connection overwrites the oldest sample and a reader which was too slow
+     * skips the samples it missed.
+     * @ingroup PortBuffers
+     */
+    template<class T>
+    class SharedConnection
+    {
+    public:
+        typedef boost::shared_ptr< SharedConnection<T> > shared_ptr;
+        typedef typename boost::call_traits<T>::param_type param_t;
+        typedef typename boost::call_traits<T>::reference reference_t;
+
+    private:
+        struct DataBuf {
+            DataBuf(param_t sample)
+                : data(sample), seq(0), in_ring(false), next(0)
+            {
+                ORO_ATOMIC_SETUP(&counter, 0);
+            }
+            ~DataBuf() {
+                ORO_ATOMIC_CLEANUP(&counter);
+            }
+            T data;
+            /** The sequence number of the sample in \a data. */
+            unsigned int volatile seq;
+            /** Number of readers reading or locking this buffer. */
+            mutable oro_atomic_t counter;
+            /** Only modified by the writer: true if a ring slot refers to this buffer. */
+            bool in_ring;
+            /** The next buffer in the (append-only) pool. */
+            DataBuf* volatile next;
+        };
+
+    public:
+        /**
+         * The read position of one reader in the shared storage.
+         */
+        struct Cursor {
+            Cursor() : next_seq(1), last(0), used(0), next(0) {}
+            /** The sequence number of the next sample to read. */
+            unsigned int volatile next_seq;
+            /** The buffer last read, which remains locked for OldData. */
+            DataBuf* last;
+            /** One if this cursor is attached to a reader, two while it is being attached
+             * and three if its reader was disconnected but not yet destroyed. */
+            int volatile used;
+            /** The next cursor in the (append-only) list of cursors. */
+            Cursor* volatile next;
+        };
+
+    private:
+        const int mtype;
+        const unsigned int msize;
+        /** The number of ring slots minus one, the number of slots is a power of two. */
+        const unsigned int mmask;
+        /** The sequence number of the last written sample. */
+        oro_atomic_t write_seq;
+        /** True once a sample was written, write_seq may be zero again after wrapping. */
+        bool volatile mwritten;
+        DataBuf* volatile * ring;
+        DataBuf* volatile pool;
+        DataBuf* write_hint;
+        /** The buffer returned by loan(), until it is published. */
+        DataBuf* loaned;
+        Cursor* volatile cursors;
+        /** A sample used to initialize buffers added by attach(). */
+        T msample;
+
+        /** Returns the smallest power of two not less than \a size. */
+        static unsigned int roundUp(unsigned int size) {
+            unsigned int n = 1;
+            while ( n < size )
+                n <<= 1;
+            return n;
+        }
+
+        void addBuffer(param_t sample) {
+            DataBuf* buf = new DataBuf(sample);
+            DataBuf* head;
+            do {
+                head = pool;
+                buf->next = head;
+            } while ( !os::CAS(&pool, head, buf) );
+        }
+
+        /**
+         * Called by the writer: finds a buffer that is not in the ring and
+         * not locked by any reader.
+         */
+        DataBuf* findFree() {
+            DataBuf* start = write_hint ? write_hint : pool;
+            DataBuf* buf = start;
+            do {
+                if ( !buf->in_ring && oro_atomic_read(&buf->counter) == 0 ) {
+                    write_hint = buf->next;
+                    return buf;
+                }
+                buf = buf->next ? buf->next : pool;
+            } while ( buf != start );
+            return 0;
+        }
+
+        /** Returns true if a BUFFER connection has no more room for the slowest reader. */
+        bool isFull(unsigned int seq) const {
+            if ( mtype != ConnPolicy::BUFFER )
+                return false;
+            for ( Cursor* c = cursors; c; c = c->next )
+                if ( c->used == 1 && seq - c->next_seq >= msize )
+                    return true;
+            return false;
+        }
+
+        /**
+         * Locks the next sample of \a c and advances its cursor.
+         * @return the locked buffer or null if there is no new sample.
+         */
+        DataBuf* pop(Cursor* c) {
+            while (true) {
+                unsigned int head = oro_atomic_read(&write_seq);
+                // unsigned arithmetic handles wrapping of the sequence numbers.
+                unsigned int available = head - c->next_seq + 1;
+                if ( available == 0 || available > 0x80000000u )
+                    return 0;
+                if ( mtype == ConnPolicy::DATA )
+                    c->next_seq = head;
+                else if ( available > msize )
+                    c->next_seq = head - msize + 1; // we missed samples.
+                DataBuf* volatile & slot = ring[ c->next_seq & mmask ];
+                DataBuf* buf = slot;
+                if ( buf == 0 )
+                    return 0;
+                oro_atomic_inc(&buf->counter);
+                // if the slot was overwritten in between, we start over.
+                if ( buf == slot && buf->seq == c->next_seq ) {
+                    c->next_seq = c->next_seq + 1;
+                    return buf;
+                }
+                oro_atomic_dec(&buf->counter);
+            }
+        }
+
+        /** Puts \a buf in the ring as the sample with sequence number \a seq. */
+        void commit(DataBuf* buf, unsigned int seq) {
+            buf->seq  = seq;
+            DataBuf* volatile & slot = ring[ seq & mmask ];
+            DataBuf* old = slot;
+            buf->in_ring = true;
+            os::CAS(&slot, old, buf);
+            if ( old )
+                old->in_ring = false;
+            oro_atomic_inc(&write_seq);
+            mwritten = true;
+        }
+
+        SharedConnection( SharedConnection const& );
+        SharedConnection& operator=( SharedConnection const& );
+    public:
+        /**
+         * Creates the storage for the shared connections with the given \a policy.
+         * @param policy Only the type and size are used.
+         * @param sample A sample which is used to allocate the buffers.
+         */
+        SharedConnection( ConnPolicy const& policy, param_t sample = T() )
+            : mtype( policy.type ),
+              msize( policy.type == ConnPolicy::DATA || policy.size <= 0 ? 1 : policy.size ),
+              mmask( roundUp(msize) - 1 ), mwritten(false),
+              ring(0), pool(0), write_hint(0), loaned(0), cursors(0), msample(sample)
+        {
+            ORO_ATOMIC_SETUP(&write_seq, 0);
+            ring = new DataBuf* volatile[mmask + 1];
+            for (unsigned int i = 0; i != mmask + 1; ++i) {
+                ring[i] = 0;
+                addBuffer(sample);
+            }
+            addBuffer(sample);
+            addBuffer(sample);
+        }
+
+        ~SharedConnection() {
+            delete[] ring;
+            while (pool) {
+                DataBuf* buf = pool;
+                pool = buf->next;
+                delete buf;
+            }
+            while (cursors) {
+                Cursor* c = cursors;
+                cursors = c->next;
+                delete c;
+            }
+            ORO_ATOMIC_CLEANUP(&write_seq);
+        }
+
+        /**
+         * Returns true if a connection with \a policy can use this storage.
+         */
+        bool isCompatible( ConnPolicy const& policy ) const {
+            if ( policy.type != mtype )
+                return false;
+            return mtype == ConnPolicy::DATA || (unsigned int)policy.size == msize;
+        }
+
+        /**
+         * Adds a reader to this storage.
+         * @param init If true, the reader will read the last written sample as new data.
+         * @return A cursor that must be passed to read() and detach().
+         */
+        Cursor* attach( bool init ) {
+            Cursor* c = 0;
+            // try to reuse a detached cursor first.
+            for ( Cursor* it = cursors; it && !c; it = it->next )
+                if ( os::CAS(&it->used, 0, 2) )
+                    c = it;
+            if ( !c ) {
+                // A new reader requires a locked and a reading buffer.
+                addBuffer(msample);
+                addBuffer(msample);
+                c = new Cursor();
+                c->used = 2;
+                Cursor* head;
+                do {
+                    head = cursors;
+                    c->next = head;
+                } while ( !os::CAS(&cursors, head, c) );
+            }
+            // mwritten is set after write_seq was incremented.
+            bool written = mwritten;
+            oro_rmb();
+            unsigned int head = oro_atomic_read(&write_seq);
+            c->last = 0;
+            c->next_seq = (init && written) ? head : head + 1;
+            os::CAS(&c->used, 2, 1);
+            return c;
+        }
+
+        /**
+         * Stops taking a reader into account when checking if a BUFFER is full.
+         * The cursor remains owned by the reader until detach().
+         */
+        void deactivate( Cursor* c ) {
+            os::CAS(&c->used, 1, 3);
+        }
+
+        /**
+         * Removes a reader from this storage. The cursor may be reused by attach().
+         */
+        void detach( Cursor* c ) {
+            if ( c->last )
+                oro_atomic_dec(&c->last->counter);
+            c->last = 0;
+            if ( !os::CAS(&c->used, 1, 0) )
+                os::CAS(&c->used, 3, 0);
+        }
+
+        /**
+         * Writes a sample into the shared storage.
+         * @return false if the sample could not be stored
+         * because the buffer was full.
+         */
+        bool write( param_t sample ) {
+            unsigned int seq = oro_atomic_read(&write_seq) + 1;
+            if ( isFull(seq) )
+                return false;
+            DataBuf* buf = findFree();
+            if ( buf == 0 )
+                return false;
+            buf->data = sample;
+            commit(buf, seq);
+            return true;
+        }
+
+        /**
+         * Reserves a buffer for the writer, which it fills in
+         * and then writes with publish(). Calling loan() again before
+         * publish() returns the same buffer.
+         * @return null if all buffers are in use.
+         */
+        T* loan() {
+            if ( loaned == 0 ) {
+                loaned = findFree();
+                if ( loaned == 0 )
+                    return 0;
+                // keeps findFree() from returning it again.
+                loaned->in_ring = true;
+            }
+            return &loaned->data;
+        }
+
+        /**
+         * Writes the buffer returned by loan() into the shared storage.
+         * @return false if nothing was loaned or if the sample
+         * could not be stored because the buffer was full.
+         */
+        bool publish() {
+            DataBuf* buf = loaned;
+            if ( buf == 0 )
+                return false;
+            loaned = 0;
+            unsigned int seq = oro_atomic_read(&write_seq) + 1;
+            if ( isFull(seq) ) {
+                buf->in_ring = false;
+                return false;
+            }
+            commit(buf, seq);
+            return true;
+        }
+
+        /**
+         * Reads the next sample for the reader of \a c.
+         */
+        FlowStatus read( Cursor* c, reference_t sample, bool copy_old_data ) {
+            T const* result = 0;
+            FlowStatus status = take(c, result);
+            if ( status == NewData || (status == OldData && copy_old_data) )
+                sample = *result;
+            return status;
+        }
+
+        /**
+         * Reads the next sample for the reader of \a c without copying it.
+         * @param sample Is set to the sample, which remains valid until the
+         * next read(), take(), clear() or detach() of \a c.
+         */
+        FlowStatus take( Cursor* c, T const*& sample ) {
+            DataBuf* buf = pop(c);
+            if ( buf ) {
+                if ( c->last )
+                    oro_atomic_dec(&c->last->counter);
+                c->last = buf;
+                sample = &buf->data;
+                return NewData;
+            }
+            if ( c->last ) {
+                sample = &c->last->data;
+                return OldData;
+            }
+            return NoData;
+        }
+
+        /**
+         * Discards all samples for the reader of \a c.
+         */
+        void clear( Cursor* c ) {
+            if ( c->last )
+                oro_atomic_dec(&c->last->counter);
+            c->last = 0;
+            c->next_seq = oro_atomic_read(&write_seq) + 1;
+        }
+
+        /**
+         * Returns the sample used to allocate the buffers of this storage.
+         */
+        T data_sample() const {
+            return msample;
+        }
+    };
+}}
+
+#endif
@@ -46,6 +46,7 @@
 #ifndef RTT_TSPOOL_HPP_
 #define RTT_TSPOOL_HPP_
 
+#include "../rtt-config.h"
 #include "../os/CAS.hpp"
 #include <assert.h>
 
@@ -78,11 +79,15 @@ namespace RTT
              * The implementation assumes that value
              * is the first element of this struct
              * and that there are no virtual functions in this class.
+             * The items are a cache line apart, such that threads
+             * which use neighbouring items do not invalidate each
+             * other's caches, nor the cache line of head.
              */
             struct Item
             {
                 value_t value;
                 volatile Pointer_t next;
+                char pad[ORO_CACHE_LINE_SIZE];
 
                 Item() :
                     value(value_t())
@@ -92,6 +97,7 @@ namespace RTT
             };
 
             Item* pool;
+            char pad[ORO_CACHE_LINE_SIZE];
             Item head;
 
             unsigned int pool_size, pool_capacity;
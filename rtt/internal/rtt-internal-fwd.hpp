@@ -12,6 +12,7 @@ namespace RTT {
         class OffsetDataSource;
         class OperationCallerC;
         class OperationInterfacePartHelper;
+        class ParallelLanes;
         class SendHandleC;
         class SignalBase;
         class SimpleConnID;
@@ -137,6 +138,8 @@ namespace RTT {
         template<typename T>
         class ChannelDataElement;
         template<typename T>
+        class ChannelSharedElement;
+        template<typename T>
         class ConnInputEndpoint;
         template<typename T>
         class ConnOutputEndpoint;
@@ -159,6 +162,8 @@ namespace RTT {
         template<typename T>
         class ReferenceDataSource;
         template<typename T>
+        class SharedConnection;
+        template<typename T>
         class TsPool;
         template<typename T>
         class ValueDataSource;
@@ -0,0 +1,108 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  Event.cpp
+
+                        Event.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "Event.hpp"
+#include "CAS.hpp"
+
+#ifdef OROPKG_OS_GNULINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace RTT { namespace os {
+
+    Event::Event()
+        : mstate(0)
+    {
+#ifndef OROPKG_OS_GNULINUX
+        rtos_sem_init(&msem, 0);
+#endif
+    }
+
+    Event::~Event()
+    {
+#ifndef OROPKG_OS_GNULINUX
+        rtos_sem_destroy(&msem);
+#endif
+    }
+
+    bool Event::signal()
+    {
+        int old;
+        do {
+            old = mstate;
+            if (old == 1)
+                return false;
+        } while ( !CAS(&mstate, old, 1) );
+        if (old == 0)
+            return false;
+        // the waiter announced it sleeps.
+#ifdef OROPKG_OS_GNULINUX
+        syscall(SYS_futex, &mstate, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);
+#else
+        rtos_sem_signal(&msem);
+#endif
+        return true;
+    }
+
+    void Event::wait()
+    {
+        while ( !CAS(&mstate, 1, 0) ) {
+#ifdef OROPKG_OS_GNULINUX
+            // returns directly if mstate is no longer -1 when the kernel checks it.
+            if ( mstate == -1 || CAS(&mstate, 0, -1) )
+                syscall(SYS_futex, &mstate, FUTEX_WAIT_PRIVATE, -1, 0, 0, 0);
+#else
+            // every 0 -> -1 transition is followed by exactly one rtos_sem_signal().
+            if ( CAS(&mstate, 0, -1) )
+                rtos_sem_wait(&msem);
+#endif
+        }
+    }
+
+    bool Event::trywait()
+    {
+        return CAS(&mstate, 1, 0);
+    }
+
+    bool Event::isSet() const
+    {
+        return mstate == 1;
+    }
+}}
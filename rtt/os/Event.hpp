@@ -0,0 +1,103 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  Event.hpp
+
+                        Event.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef RTT_OS_EVENT_HPP
+#define RTT_OS_EVENT_HPP
+
+#include "fosi.h"
+#include "../rtt-config.h"
+
+namespace RTT
+{ namespace os {
+    /**
+     * A binary event on which one thread at a time can \a wait() until
+     * another thread \a signal()s it. Signals which arrive while the
+     * event is already set are merged into one.
+     *
+     * Signalling only wakes up the waiting thread with a system call when
+     * that thread actually sleeps. When the thread is busy, signal() only
+     * sets the event, which the thread picks up in its next wait(). On
+     * gnulinux, sleeping is done with a futex on the state of the event,
+     * on other targets with a semaphore.
+     */
+    class RTT_API Event
+    {
+    public:
+        /**
+         * Create an event which is not set.
+         */
+        Event();
+
+        ~Event();
+
+        /**
+         * Set the event and wake up the thread sleeping in wait(), if any.
+         * @return true if a sleeping thread had to be woken up.
+         */
+        bool signal();
+
+        /**
+         * Wait until the event is set, and clear it.
+         */
+        void wait();
+
+        /**
+         * Clear the event if it is set, without waiting.
+         * @return true if the event was set.
+         */
+        bool trywait();
+
+        /**
+         * Returns true if the event is set.
+         */
+        bool isSet() const;
+
+    private:
+        Event(const Event&);
+
+        /**
+         * 1 if set, 0 if not set and -1 if not set
+         * and a thread sleeps in wait().
+         */
+        volatile int mstate;
+#ifndef OROPKG_OS_GNULINUX
+        rt_sem_t msem;
+#endif
+    };
+}}
+
+#endif
@@ -125,6 +125,11 @@ namespace RTT
             return 0;
         }
 
+        unsigned int MainThread::getOverrunCount() const
+        {
+            return 0;
+        }
+
     void MainThread::setWaitPeriodPolicy(int p)
     {
         rtos_task_set_wait_period_policy(&main_task, p);
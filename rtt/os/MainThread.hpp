@@ -132,6 +132,8 @@ namespace RTT
 
         virtual int getMaxOverrun() const;
 
+        virtual unsigned int getOverrunCount() const;
+
         virtual void setWaitPeriodPolicy(int p);
 
         virtual void yield();
@@ -0,0 +1,194 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  MemoryArena.cpp
+
+                        MemoryArena.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "MemoryArena.hpp"
+
+#ifdef OS_RT_MALLOC
+
+#include "CAS.hpp"
+#include "../Logger.hpp"
+#include <cstdlib>
+#define ORO_MEMORY_POOL
+#include "tlsf/tlsf.h"
+
+namespace RTT
+{ namespace os {
+
+    namespace {
+        __thread MemoryArena* current_arena = 0;
+    }
+
+    MemoryArena::MemoryArena(std::size_t size)
+        : mpool(0), msize(size), mowned(true), mblocks(0), mfailures(0), mremote(0)
+    {
+        init( std::malloc(size), size );
+    }
+
+    MemoryArena::MemoryArena(void* memory, std::size_t size)
+        : mpool(0), msize(size), mowned(false), mblocks(0), mfailures(0), mremote(0)
+    {
+        init( memory, size );
+    }
+
+    void MemoryArena::init(void* memory, std::size_t size)
+    {
+        oro_atomic_set(&mremote_frees, 0);
+        if ( memory && init_private_memory_pool(size, memory) != (size_t)-1 )
+            mpool = memory;
+        else {
+            log(Error) << "MemoryArena: could not create a pool of " << size << " bytes." << endlog();
+            if (mowned)
+                std::free(memory);
+        }
+    }
+
+    MemoryArena::~MemoryArena()
+    {
+        if ( current_arena == this )
+            current_arena = 0;
+        if ( !mpool )
+            return;
+        reclaim();
+        if ( mblocks != 0 )
+            log(Error) << "MemoryArena destroyed with " << mblocks << " blocks in use." << endlog();
+        destroy_memory_pool(mpool);
+        if (mowned)
+            std::free(mpool);
+    }
+
+    void MemoryArena::reclaim()
+    {
+        Header* h;
+        do {
+            h = mremote;
+        } while ( h && !os::CAS(&mremote, h, (Header*)0) );
+        while ( h ) {
+            Header* next = h->next;
+            free_ex(h, mpool);
+            --mblocks;
+            h = next;
+        }
+    }
+
+    std::size_t MemoryArena::getUsedSize() const
+    {
+        return mpool ? get_used_size(mpool) : 0;
+    }
+
+    std::size_t MemoryArena::getMaxUsedSize() const
+    {
+        return mpool ? get_max_size(mpool) : 0;
+    }
+
+    int MemoryArena::getBlocks() const
+    {
+        return mblocks;
+    }
+
+    int MemoryArena::getRemoteFrees() const
+    {
+        return oro_atomic_read(&mremote_frees);
+    }
+
+    MemoryArena::Header* MemoryArena::allocateBlock(std::size_t size)
+    {
+        if ( !mpool )
+            return 0;
+        if ( mremote )
+            reclaim();
+        Header* h = static_cast<Header*>( malloc_ex(size, mpool) );
+        if ( h ) {
+            h->arena = this;
+            ++mblocks;
+        } else
+            ++mfailures;
+        return h;
+    }
+
+    void MemoryArena::deallocateBlock(Header* h)
+    {
+        if ( current_arena == this ) {
+            free_ex(h, mpool);
+            --mblocks;
+            return;
+        }
+        Header* head;
+        do {
+            head = mremote;
+            h->next = head;
+        } while ( !os::CAS(&mremote, head, h) );
+        oro_atomic_inc(&mremote_frees);
+    }
+
+    MemoryArena* MemoryArena::Current()
+    {
+        return current_arena;
+    }
+
+    void MemoryArena::SetCurrent(MemoryArena* arena)
+    {
+        current_arena = arena;
+    }
+
+    void* MemoryArena::Allocate(std::size_t size)
+    {
+        Header* h = 0;
+        if ( current_arena )
+            h = current_arena->allocateBlock( size + sizeof(Header) );
+        if ( !h ) {
+            h = static_cast<Header*>( oro_rt_malloc( size + sizeof(Header) ) );
+            if ( !h )
+                return 0;
+            h->arena = 0;
+        }
+        return h + 1;
+    }
+
+    void MemoryArena::Deallocate(void* p)
+    {
+        if ( !p )
+            return;
+        Header* h = static_cast<Header*>(p) - 1;
+        if ( h->arena )
+            h->arena->deallocateBlock(h);
+        else
+            oro_rt_free(h);
+    }
+}}
+
+#endif
@@ -0,0 +1,175 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  MemoryArena.hpp
+
+                        MemoryArena.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_OS_MEMORY_ARENA_HPP
+#define ORO_OS_MEMORY_ARENA_HPP
+
+#include "../rtt-config.h"
+#include "oro_arch.h"
+#include <cstddef>
+
+#ifdef OS_RT_MALLOC
+
+namespace RTT
+{ namespace os {
+
+    /**
+     * A TLSF memory pool of its own for the real-time allocations
+     * of one thread, such that threads do not contend for the lock
+     * of the global pool of oro_rt_malloc().
+     *
+     * A thread uses an arena after SetCurrent(), or after
+     * Thread::setMemoryArena() for the thread of an Activity. Only that
+     * thread allocates from the arena, which is why no lock is needed.
+     * Any thread may release a block: the owner returns it to the pool
+     * at once, other threads push it on a lock-free list, which the
+     * owner reclaims at its next allocation.
+     *
+     * rt_allocator allocates with Allocate(), which uses the arena of the
+     * current thread if there is one and the global pool otherwise.
+     * @warning An arena must outlive all blocks allocated from it.
+     */
+    class RTT_API MemoryArena
+    {
+    public:
+        /**
+         * Allocates a pool of \a size bytes on the heap.
+         */
+        MemoryArena(std::size_t size);
+
+        /**
+         * Uses the \a size bytes at \a memory as pool. The memory
+         * must remain valid as long as this object exists.
+         */
+        MemoryArena(void* memory, std::size_t size);
+
+        ~MemoryArena();
+
+        /**
+         * Returns the blocks which other threads released to the pool.
+         * Only call this from the thread which uses this arena.
+         */
+        void reclaim();
+
+        /**
+         * The size of the pool.
+         */
+        std::size_t getSize() const { return msize; }
+
+        /**
+         * The number of bytes in use, including the TLSF headers.
+         * Returns zero if TLSF was built without OS_RT_MALLOC_STATS.
+         */
+        std::size_t getUsedSize() const;
+
+        /**
+         * The largest number of bytes that were in use at once.
+         * Returns zero if TLSF was built without OS_RT_MALLOC_STATS.
+         */
+        std::size_t getMaxUsedSize() const;
+
+        /**
+         * The number of blocks which were allocated and not freed yet.
+         */
+        int getBlocks() const;
+
+        /**
+         * The number of blocks which were released by other threads.
+         */
+        int getRemoteFrees() const;
+
+        /**
+         * The number of allocations which did not fit in this arena
+         * and were served from the global pool.
+         */
+        int getFailures() const { return mfailures; }
+
+        /**
+         * Returns the arena of the calling thread, or null.
+         */
+        static MemoryArena* Current();
+
+        /**
+         * Lets the calling thread allocate from \a arena.
+         * Use null to allocate from the global pool again.
+         */
+        static void SetCurrent(MemoryArena* arena);
+
+        /**
+         * Allocates \a size bytes from the arena of the calling thread,
+         * or from the global pool if it has none or if it is full.
+         * @return null if no memory is available.
+         */
+        static void* Allocate(std::size_t size);
+
+        /**
+         * Releases a block returned by Allocate(), from any thread.
+         */
+        static void Deallocate(void* p);
+
+    private:
+        MemoryArena(const MemoryArena&);
+
+        /**
+         * Precedes every block returned by Allocate(). Its size keeps
+         * the alignment of TLSF, which is two pointers.
+         */
+        struct Header {
+            MemoryArena* arena;
+            Header* next;
+        };
+
+        void init(void* memory, std::size_t size);
+        Header* allocateBlock(std::size_t size);
+        void deallocateBlock(Header* h);
+
+        void* mpool;
+        std::size_t msize;
+        bool mowned;
+        int mblocks;
+        int mfailures;
+        /**
+         * The blocks released by other threads, linked by Header::next.
+         */
+        Header* volatile mremote;
+        oro_atomic_t mremote_frees;
+    };
+}}
+
+#endif
+#endif
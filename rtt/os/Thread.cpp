@@ -41,6 +41,7 @@
 #include "threads.hpp"
 #include "../Logger.hpp"
 #include "MutexLock.hpp"
+#include "MemoryArena.hpp"
 
 #include "../rtt-config.h"
 #include "../internal/CatchConfig.hpp"
@@ -82,7 +83,7 @@ namespace RTT {
             task->configure();
 
             // signal to setup() that we're created.
-            rtos_sem_signal(&(task->sem));
+            task->sem.signal();
 
             // This lock forces setup(), which holds the lock, to continue.
             { MutexLock lock(task->breaker); }
@@ -111,7 +112,7 @@ namespace RTT {
                                 // drop out of periodic mode:
                                 rtos_task_set_period(task->getTask(), 0);
                             }
-                            rtos_sem_wait(&(task->sem)); // wait for command.
+                            task->sem.wait(); // wait for command.
                             task->configure();           // check for reconfigure
                             if (task->prepareForExit)    // check for exit
                             {
@@ -159,6 +160,7 @@ namespace RTT {
                                     if (rtos_task_wait_period(task->getTask()) != 0)
                                     {
                                         ++overruns;
+                                        ++task->overrunCount;
                                         if (overruns == task->maxOverRun)
                                             break; // break while(task->running)
                                     }
@@ -236,12 +238,15 @@ namespace RTT {
                 Seconds periods, unsigned cpu_affinity, const std::string & name) :
                     msched_type(scheduler), active(false), prepareForExit(false),
                     inloop(false),running(false),
-                    maxOverRun(OROSEM_OS_PERIODIC_THREADS_MAX_OVERRUN),
+                    maxOverRun(OROSEM_OS_PERIODIC_THREADS_MAX_OVERRUN), overrunCount(0),
                     period(Seconds_to_nsecs(periods)) // Do not call setPeriod(), since the semaphores are not yet used !
 #ifdef OROPKG_OS_THREAD_SCOPE
         ,d(NULL)
 #endif
                     , stopTimeout(0)
+#ifdef OS_RT_MALLOC
+                    , marena(0)
+#endif
         {
             this->setup(_priority, cpu_affinity, name);
         }
@@ -249,7 +254,6 @@ namespace RTT {
         void Thread::setup(int _priority, unsigned cpu_affinity, const std::string& name)
         {
             Logger::In in("Thread");
-            int ret;
 
             // we do this under lock in order to force the thread to wait until we're done.
             MutexLock lock(breaker);
@@ -259,21 +263,6 @@ namespace RTT {
                       << ", CPU affinity=" << cpu_affinity
                       << ", with name='" << name << "'"
                       << endlog();
-            ret = rtos_sem_init(&sem, 0);
-            if (ret != 0)
-            {
-                log(Critical)
-                        << "Could not allocate configuration semaphore 'sem' for "
-                        << name
-                        << ". Throwing std::bad_alloc." << endlog();
-                rtos_sem_destroy(&sem);
-#ifndef ORO_EMBEDDED
-                throw std::bad_alloc();
-#else
-                return;
-#endif
-            }
-
 #ifdef OROPKG_OS_THREAD_SCOPE
             // Check if threadscope device already exists
 
@@ -295,7 +284,6 @@ namespace RTT {
                 log(Critical) << "Could not create thread "
                         << name << "."
                         << endlog();
-                rtos_sem_destroy(&sem);
 #ifndef ORO_EMBEDDED
                 throw std::bad_alloc();
 #else
@@ -304,7 +292,7 @@ namespace RTT {
             }
 
             // Wait for creation of thread.
-            rtos_sem_wait( &sem );
+            sem.wait();
 
             const char* modname = getName();
             Logger::In in2(modname);
@@ -330,7 +318,6 @@ namespace RTT {
             log(Debug) << "Terminating " << this->getName() << endlog();
             terminate();
             log(Debug) << " done" << endlog();
-            rtos_sem_destroy(&sem);
 
         }
 
@@ -340,21 +327,12 @@ namespace RTT {
             {
                 // just signal if already active.
                 if ( isActive() ) {
-#ifndef OROPKG_OS_MACOSX
-                    // This is a 'weak' race condition.
-                    // it could be that sem becomes zero
-                    // after this check. Technically, this means
-                    // loop is being executed (preemption) during start().
-                    // For most user code, this is sufficient though, as it
-                    // can not know the difference between executing loop()
-                    // *in* start or *right after* start (the latter is
-                    // guaranteed by the API).
-                    // @see ActivityInterface::trigger for how trigger uses this
-                    // assumption.
-                    if ( rtos_sem_value(&sem) > 0 )
-                        return true;
-#endif
-                    rtos_sem_signal(&sem);
+                    // Pending signals are merged, and the thread is only
+                    // woken up with a system call when it sleeps. When it
+                    // is executing loop(), it executes loop() once more
+                    // *right after* this one (which is what the API
+                    // guarantees). @see ActivityInterface::trigger
+                    sem.signal();
                     return true;
                 }
 
@@ -365,7 +343,7 @@ namespace RTT {
                 }
 
                 running = true;
-                rtos_sem_signal(&sem);
+                sem.signal();
 
                 return true;
             }
@@ -388,11 +366,7 @@ namespace RTT {
 
                 // signal start :
                 rtos_task_make_periodic(&rtos_task, period);
-                int ret = rtos_sem_signal(&sem);
-                if (ret != 0)
-                    log(Critical)
-                    << "Thread::start(): sem_signal returns " << ret
-                    << endlog();
+                sem.signal();
                 // do not wait, we did our job.
 
                 return true;
@@ -480,7 +454,7 @@ namespace RTT {
                       << sched_type << endlog();
             rtos_task_set_scheduler(&rtos_task, sched_type); // this may be a no-op, in that case, configure() will pick the change up.
             msched_type = sched_type;
-            rtos_sem_signal(&sem);
+            sem.signal();
             return true; // we assume all will go well.
         }
 
@@ -500,6 +474,10 @@ namespace RTT {
             // reconfigure period
             rtos_task_set_period(&rtos_task, period);
 
+#ifdef OS_RT_MALLOC
+            MemoryArena::SetCurrent(marena);
+#endif
+
             // reconfigure scheduler.
             if (msched_type != rtos_task_get_scheduler(&rtos_task))
             {
@@ -512,6 +490,18 @@ namespace RTT {
         {
         }
 
+#ifdef OS_RT_MALLOC
+        void Thread::setMemoryArena(MemoryArena* arena)
+        {
+            marena = arena;
+        }
+
+        MemoryArena* Thread::getMemoryArena() const
+        {
+            return marena;
+        }
+#endif
+
         void Thread::loop()
         {
             this->step();
@@ -552,7 +542,7 @@ namespace RTT {
                 // jump from non periodic into periodic: first sample.
                 if ( period == 0) {
                     period = nsperiod; // avoid race with sem in thread func.
-                    rtos_sem_signal(&sem);
+                    sem.signal();
                 }
             }
             // update rate:
@@ -623,7 +613,7 @@ namespace RTT {
             if (prepareForExit) return;
 
             prepareForExit = true;
-            rtos_sem_signal(&sem);
+            sem.signal();
 
             rtos_task_delete(&rtos_task); // this must join the thread.
         }
@@ -643,6 +633,11 @@ namespace RTT {
             return maxOverRun;
         }
 
+        unsigned int Thread::getOverrunCount() const
+        {
+            return overrunCount;
+        }
+
         void Thread::setWaitPeriodPolicy(int p)
         {
             rtos_task_set_wait_period_policy(&rtos_task, p);  
@@ -44,6 +44,7 @@
 
 #include "ThreadInterface.hpp"
 #include "Mutex.hpp"
+#include "Event.hpp"
 
 #include <string>
 
@@ -52,6 +53,10 @@ namespace RTT
 
     namespace os
     {
+#ifdef OS_RT_MALLOC
+        class MemoryArena;
+#endif
+
         /**
          * A Thread object executes user code in its own thread.
          *
@@ -238,8 +243,26 @@ namespace RTT
 
             virtual int getMaxOverrun() const;
 
+            virtual unsigned int getOverrunCount() const;
+
             virtual void setWaitPeriodPolicy(int p);
 
+#ifdef OS_RT_MALLOC
+            /**
+             * Lets this thread allocate real-time memory from \a arena
+             * instead of the global pool. The thread picks it up when
+             * it is started.
+             * @param arena The arena, which must outlive this thread and
+             * all memory allocated from it, or null to use the global pool.
+             */
+            void setMemoryArena(MemoryArena* arena);
+
+            /**
+             * Returns the arena set with setMemoryArena(), or null.
+             */
+            MemoryArena* getMemoryArena() const;
+#endif
+
         protected:
             /**
              * Exit and destroy the thread
@@ -328,9 +351,10 @@ namespace RTT
             RTOS_TASK rtos_task;
 
             /**
-             * The semaphore used for starting the thread.
+             * The event used for starting and triggering the thread.
+             * Signalling it is cheap when the thread is busy.
              */
-            rt_sem_t sem;
+            Event sem;
 
             /**
              * Used to implement synchronising breakLoop().
@@ -343,6 +367,11 @@ namespace RTT
              */
             int maxOverRun;
 
+            /**
+             * The number of periodic overruns since this thread was created.
+             */
+            unsigned int overrunCount;
+
             /**
              * The period as it is passed to the operating system.
              */
@@ -353,6 +382,13 @@ namespace RTT
              */
             double stopTimeout;
 
+#ifdef OS_RT_MALLOC
+            /**
+             * The arena of this thread, or null.
+             */
+            MemoryArena* marena;
+#endif
+
 #ifdef OROPKG_OS_THREAD_SCOPE
             // Pointer to Threadscope device
             dev::DigitalOutInterface * d;
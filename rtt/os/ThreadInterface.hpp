@@ -194,6 +194,13 @@ namespace RTT
 
             virtual int getMaxOverrun() const = 0;
 
+            /**
+             * Returns the number of periodic overruns of this
+             * thread since it was created. The default implementation
+             * returns 0, for threads which do not detect overruns.
+             */
+            virtual unsigned int getOverrunCount() const { return 0; }
+
             /**
              * Set the wait policy of a periodic thread
              * @param The wait policy between ORO_WAIT_ABS (absolute wait) and ORO_WAIT_REL (relative wait)
@@ -42,6 +42,16 @@
 #include "../Logger.hpp"
 #include "../os/fosi.h"
 
+#ifdef ORO_OS_USE_TIMERFD
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <cstring>
+#include <unistd.h>
+#include <errno.h>
+#include <stdint.h>
+#endif
+
 namespace RTT {
     using namespace base;
     using namespace os;
@@ -72,48 +82,44 @@ namespace RTT {
                 // We can't use infinite as the OS may internally use time_spec, which can not
                 // represent as much in the future (until 2038) // XXX Year-2038 Bug
                 wake_up_time = (TimeService::InfiniteNSecs/4)-1;
-                for (TimerIds::iterator it = mtimers.begin(); it != mtimers.end(); ++it) {
-                    if ( it->expires != 0 && it->expires < wake_up_time  ) {
-                        wake_up_time = it->expires;
-                        next_timer_id = it - mtimers.begin();
-                    }
+                if ( !mheap.empty() ) {
+                    next_timer_id = mheap.front();
+                    wake_up_time = mtimers[next_timer_id].expires;
                 }
             }// MutexLock
 
             // Wait
             int ret = 0;
             if ( wake_up_time > rtos_get_time_ns() )
-                ret = msem.waitUntil( wake_up_time ); // case of no timers or running timers
+                ret = waitUntil( wake_up_time ); // case of no timers or running timers
             else
-                ret = -1; // case of timer overrun.
+                ret = -1; // case of timer overrun or of more timers expired at this wake-up.
 
             // Timeout handling
             if (ret == -1) {
                 // a timer expired
-                // expires: reset/reprogram the timer that expired:
-                {
-                    MutexLock locker(m);
-                    // detect corner case for resize:
-                    if ( next_timer_id < int(mtimers.size()) ) {
-                        // now clear or reprogram it.
-                        TimerIds::iterator tim = mtimers.begin() + next_timer_id;
-                        if ( tim->period ) {
-                            // periodic timer
-                            tim->expires += tim->period;
-                        } else {
-                            // aperiodic timer
-                            tim->expires = 0;
-                        }
-                    }
-                }
-
-                // Second: notify waiting threads
+                // First: reset/reprogram the timer that expired and
+                // notify waiting threads.
                 {// This scope is for MutexLock.
                     MutexLock locker(m);
-                    mtimers[next_timer_id].expired.broadcast();
+                    // detect corner cases for resize, kill or re-arm while waiting:
+                    if ( next_timer_id >= int(mtimers.size()) || mtimers[next_timer_id].expires != wake_up_time )
+                        continue;
+                    // now clear or reprogram it.
+                    TimerInfo& tim = mtimers[next_timer_id];
+                    if ( tim.period ) {
+                        // periodic timer
+                        tim.expires += tim.period;
+                        heapUpdate( next_timer_id );
+                    } else {
+                        // aperiodic timer
+                        tim.expires = 0;
+                        heapRemove( next_timer_id );
+                    }
+                    tim.expired.broadcast();
                 }// MutexLock
 
-                // Third: send the timeout signal and allow (within the callback)
+                // Second: send the timeout signal and allow (within the callback)
                 // to reprogram the timer.
                 // If we would expires call timeout(), the code above would overwrite
                 // user settings.
@@ -125,7 +131,7 @@ namespace RTT {
     bool Timer::breakLoop()
     {
         mdo_quit = true;
-        msem.signal();
+        wakeUp();
         // kill all timers to abort all threads blocking in waitFor()
         for (TimerId i = 0; i < (int) mtimers.size(); ++i) {
             killTimer(i);
@@ -137,6 +143,25 @@ namespace RTT {
         : mThread(0), msem(0), mdo_quit(false)
     {
         mtimers.resize(max_timers);
+        mheap.reserve(max_timers);
+#ifdef ORO_OS_USE_TIMERFD
+        mtimerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        mwakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        mepollfd = epoll_create1(EPOLL_CLOEXEC);
+        bool ok = mtimerfd >= 0 && mwakefd >= 0 && mepollfd >= 0;
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = mtimerfd;
+        ok = ok && epoll_ctl(mepollfd, EPOLL_CTL_ADD, mtimerfd, &event) == 0;
+        event.data.fd = mwakefd;
+        ok = ok && epoll_ctl(mepollfd, EPOLL_CTL_ADD, mwakefd, &event) == 0;
+        if ( !ok ) {
+            log(Warning) << "Timer could not create its timerfd and epoll set: " << strerror(errno) << ". Falling back to a semaphore." << endlog();
+            if (mepollfd >= 0)
+                close(mepollfd);
+            mepollfd = -1;
+        }
+#endif
         if (scheduler != -1) {
             mThread = new Activity(scheduler, priority, 0.0, this, "Timer");
             mThread->start();
@@ -146,6 +171,57 @@ namespace RTT {
     Timer::~Timer()
     {
         delete mThread;
+#ifdef ORO_OS_USE_TIMERFD
+        if (mepollfd >= 0)
+            close(mepollfd);
+        if (mtimerfd >= 0)
+            close(mtimerfd);
+        if (mwakefd >= 0)
+            close(mwakefd);
+#endif
+    }
+
+    int Timer::waitUntil(Time wake_up_time)
+    {
+#ifdef ORO_OS_USE_TIMERFD
+        if ( mepollfd >= 0 ) {
+            // The timerfd uses the monotonic clock, such that it is not
+            // affected by changes of the system time while it waits.
+            Time remaining = wake_up_time - rtos_get_time_ns();
+            if ( remaining <= 0 )
+                return -1;
+            itimerspec spec;
+            spec.it_interval.tv_sec = spec.it_interval.tv_nsec = 0;
+            spec.it_value.tv_sec = remaining / 1000000000LL;
+            spec.it_value.tv_nsec = remaining % 1000000000LL;
+            timerfd_settime(mtimerfd, 0, &spec, 0);
+
+            epoll_event events[2];
+            int n = epoll_wait(mepollfd, events, 2, -1);
+            int ret = 0;
+            uint64_t count;
+            for (int i = 0; i < n; ++i) {
+                // reading resets the timerfd expirations and the eventfd counter.
+                if ( read(events[i].data.fd, &count, sizeof(count)) == sizeof(count) && events[i].data.fd == mtimerfd )
+                    ret = -1;
+            }
+            return ret;
+        }
+#endif
+        return msem.waitUntil( wake_up_time );
+    }
+
+    void Timer::wakeUp()
+    {
+#ifdef ORO_OS_USE_TIMERFD
+        if ( mepollfd >= 0 ) {
+            uint64_t one = 1;
+            if ( write(mwakefd, &one, sizeof(one)) != sizeof(one) && errno != EAGAIN )
+                log(Error) << "Timer could not wake up its thread: " << strerror(errno) << endlog();
+            return;
+        }
+#endif
+        msem.signal();
     }
 
 
@@ -157,7 +233,10 @@ namespace RTT {
     void Timer::setMaxTimers(TimerId max)
     {
         MutexLock locker(m);
+        for (TimerId i = max; i < int(mtimers.size()); ++i)
+            heapRemove(i);
         mtimers.resize(max, TimerInfo() );
+        mheap.reserve(max);
     }
 
     bool Timer::startTimer(TimerId timer_id, double period)
@@ -170,12 +249,17 @@ namespace RTT {
 
         Time due_time = rtos_get_time_ns() + Seconds_to_nsecs( period );
 
+        bool first;
         {
             MutexLock locker(m);
             mtimers[timer_id].expires = due_time;
             mtimers[timer_id].period = Seconds_to_nsecs( period );
+            heapUpdate( timer_id );
+            first = mheap.front() == timer_id;
         }
-        msem.signal();
+        // only wake up the loop if it must wait less long.
+        if ( first )
+            wakeUp();
         return true;
     }
 
@@ -190,12 +274,17 @@ namespace RTT {
         Time now = rtos_get_time_ns();
         Time due_time = now + Seconds_to_nsecs( wait_time );
 
+        bool first;
         {
             MutexLock locker(m);
             mtimers[timer_id].expires  = due_time;
             mtimers[timer_id].period = 0;
+            heapUpdate( timer_id );
+            first = mheap.front() == timer_id;
         }
-        msem.signal();
+        // only wake up the loop if it must wait less long.
+        if ( first )
+            wakeUp();
         return true;
     }
 
@@ -236,6 +325,7 @@ namespace RTT {
         }
         mtimers[timer_id].expires = 0;
         mtimers[timer_id].period = 0;
+        heapRemove( timer_id );
         mtimers[timer_id].expired.broadcast();
         return true;
     }
@@ -266,6 +356,78 @@ namespace RTT {
         return mtimers[timer_id].expired.wait_until(m, abs_time);
     }
 
+    bool Timer::heapLess(TimerId a, TimerId b) const
+    {
+        // equal expiry times expire in order of timer id.
+        return mtimers[a].expires < mtimers[b].expires
+            || ( mtimers[a].expires == mtimers[b].expires && a < b );
+    }
+
+    void Timer::heapSet(int index, TimerId timer_id)
+    {
+        mheap[index] = timer_id;
+        mtimers[timer_id].heap_index = index;
+    }
+
+    void Timer::heapUp(int index)
+    {
+        TimerId timer_id = mheap[index];
+        while ( index > 0 ) {
+            int parent = (index - 1) / 2;
+            if ( !heapLess( timer_id, mheap[parent] ) )
+                break;
+            heapSet( index, mheap[parent] );
+            index = parent;
+        }
+        heapSet( index, timer_id );
+    }
+
+    void Timer::heapDown(int index)
+    {
+        TimerId timer_id = mheap[index];
+        int size = mheap.size();
+        while ( true ) {
+            int child = 2 * index + 1;
+            if ( child >= size )
+                break;
+            if ( child + 1 < size && heapLess( mheap[child + 1], mheap[child] ) )
+                ++child;
+            if ( !heapLess( mheap[child], timer_id ) )
+                break;
+            heapSet( index, mheap[child] );
+            index = child;
+        }
+        heapSet( index, timer_id );
+    }
+
+    void Timer::heapUpdate(TimerId timer_id)
+    {
+        int index = mtimers[timer_id].heap_index;
+        if ( index < 0 ) {
+            // does not allocate, mheap has room for all timers.
+            mheap.push_back( timer_id );
+            heapUp( mheap.size() - 1 );
+        } else {
+            heapUp( index );
+            heapDown( mtimers[timer_id].heap_index );
+        }
+    }
+
+    void Timer::heapRemove(TimerId timer_id)
+    {
+        int index = mtimers[timer_id].heap_index;
+        if ( index < 0 )
+            return;
+        mtimers[timer_id].heap_index = -1;
+        TimerId last = mheap.back();
+        mheap.pop_back();
+        if ( last == timer_id )
+            return;
+        heapSet( index, last );
+        heapUp( index );
+        heapDown( mtimers[last].heap_index );
+    }
+
 
 
 }
@@ -39,6 +39,7 @@
 #ifndef ORO_RTT_TIMER_HPP
 #define ORO_RTT_TIMER_HPP
 
+#include "../rtt-config.h"
 #include "Time.hpp"
 #include "TimeService.hpp"
 #include "Mutex.hpp"
@@ -63,6 +64,16 @@ namespace RTT
      * If you do not attach an activity, the Timer will create a thread
      * of its own and start it. That thread will be stopped and cleaned up
      * when the Timer is destroyed.
+     *
+     * The armed timers are kept in a binary heap, ordered by expiry time.
+     * Arming and killing a timer takes O(log n) time and finding the next
+     * timer to expire takes constant time, such that a Timer can hold
+     * thousands of timers.
+     *
+     * On gnulinux with ORO_OS_USE_TIMERFD, the timer thread waits in epoll
+     * for a CLOCK_MONOTONIC timerfd, which is set to the first expiry, and
+     * an eventfd, which signals changes of the timers. All timers which
+     * expired at a wake-up are handled before waiting again.
      */
     class RTT_API Timer
         : public base::RunnableInterface
@@ -75,16 +86,27 @@ namespace RTT
     protected:
         base::ActivityInterface* mThread;
         Semaphore msem;
+#ifdef ORO_OS_USE_TIMERFD
+        /**
+         * The epoll set of mtimerfd and mwakefd, or -1
+         * if they could not be created, in which case
+         * msem is used.
+         */
+        int mepollfd;
+        int mtimerfd;
+        int mwakefd;
+#endif
         mutable Mutex m;
         typedef TimeService::nsecs Time;
 
         struct TimerInfo
         {
-            TimerInfo() : expires(0), period(0) {}
+            TimerInfo() : expires(0), period(0), heap_index(-1) {}
             TimerInfo(const TimerInfo& other) { *this = other; }
-            TimerInfo& operator=(const TimerInfo& other) { this->expires = other.expires; this->period = other.period; return *this; }
+            TimerInfo& operator=(const TimerInfo& other) { this->expires = other.expires; this->period = other.period; this->heap_index = other.heap_index; return *this; }
             Time expires; // was .first
             Time period;  // was .second
+            int heap_index; // position in mheap, -1 if not armed.
             Condition expired;
         };
 
@@ -95,8 +117,41 @@ namespace RTT
          */
         typedef std::vector<TimerInfo> TimerIds;
         TimerIds mtimers;
+
+        /**
+         * The ids of the armed timers, as a binary min-heap
+         * on their expiry time. The front expires first.
+         */
+        typedef std::vector<TimerId> TimerHeap;
+        TimerHeap mheap;
         bool mdo_quit;
 
+        /**
+         * Waits until \a wake_up_time or until wakeUp() is called.
+         * @return -1 if \a wake_up_time passed, 0 otherwise.
+         */
+        int waitUntil(Time wake_up_time);
+
+        /**
+         * Lets the timer thread return from waitUntil().
+         */
+        void wakeUp();
+
+        // Heap operations, which must be called with m locked.
+        bool heapLess(TimerId a, TimerId b) const;
+        void heapSet(int index, TimerId timer_id);
+        void heapUp(int index);
+        void heapDown(int index);
+        /**
+         * Inserts \a timer_id in the heap or moves it to its new
+         * place after its expiry time changed.
+         */
+        void heapUpdate(TimerId timer_id);
+        /**
+         * Removes \a timer_id from the heap if it is in it.
+         */
+        void heapRemove(TimerId timer_id);
+
         bool initialize();
         void finalize();
         void step();
@@ -45,6 +45,7 @@
 
 #include "MutexLock.hpp"
 #include "oro_malloc.h"
+#include "MemoryArena.hpp"
 
 namespace RTT { namespace os {
     /**
@@ -246,7 +247,8 @@ namespace RTT { namespace os {
     /**
      * A real-time malloc allocator which allocates
      * every block with oro_rt_malloc() and deallocates with oro_rt_free().
-     * This relies on the TLSF implementation.
+     * This relies on the TLSF implementation. If the calling thread has
+     * a MemoryArena, the blocks come from that arena instead.
      */
     template <class T> class rt_allocator
     {
@@ -269,14 +271,22 @@ namespace RTT { namespace os {
         }
     public:
         pointer allocate(size_type n, const_pointer = 0) {
+#ifdef OS_RT_MALLOC
+            void* p = MemoryArena::Allocate(n * sizeof(T));
+#else
             void* p = oro_rt_malloc(n * sizeof(T));
+#endif
             if (!p)
                 throw std::bad_alloc();
             return static_cast<pointer>(p);
         }
 
         void deallocate(pointer p, size_type) {
+#ifdef OS_RT_MALLOC
+            MemoryArena::Deallocate(p);
+#else
             oro_rt_free(p);
+#endif
         }
 
         size_type max_size() const {
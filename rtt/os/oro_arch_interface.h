@@ -94,5 +94,25 @@ int oro_atomic_inc_and_test(oro_atomic_t *a);
  */
 int oro_cmpxchg(void volatile* ptr, unsigned long o, unsigned long n);
 
+/**
+ * Read memory barrier: the loads before this barrier
+ * complete before the loads after it. This also prevents
+ * the compiler from reordering loads across it.
+ */
+void oro_rmb();
+
+/**
+ * Write memory barrier: the stores before this barrier
+ * become visible before the stores after it. This also prevents
+ * the compiler from reordering stores across it.
+ */
+void oro_wmb();
+
+/**
+ * Full memory barrier: the loads and stores before this barrier
+ * complete before the loads and stores after it.
+ */
+void oro_mb();
+
 
 #endif // __ORO_ARCH_INTERFACE__
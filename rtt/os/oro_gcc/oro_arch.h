@@ -80,5 +80,28 @@ static __inline__ int oro_atomic_inc_and_test(oro_atomic_t *a_int)
 #define oro_cmpxchg(ptr,o,n)\
     ((__typeof__(*(ptr)))__sync_val_compare_and_swap((ptr),(o),(n)))
 
+/**
+ * Read memory barrier. x86 does not reorder loads with other loads.
+ */
+#if defined(__i386__) || defined(__x86_64__)
+#define oro_rmb() __asm__ __volatile__("": : :"memory")
+#else
+#define oro_rmb() __sync_synchronize()
+#endif
+
+/**
+ * Write memory barrier. x86 does not reorder stores with other stores.
+ */
+#if defined(__i386__) || defined(__x86_64__)
+#define oro_wmb() __asm__ __volatile__("": : :"memory")
+#else
+#define oro_wmb() __sync_synchronize()
+#endif
+
+/**
+ * Full memory barrier.
+ */
+#define oro_mb() __sync_synchronize()
+
 
 #endif // __GCC_ORO_ARCH__
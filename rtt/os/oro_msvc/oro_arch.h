@@ -103,4 +103,8 @@ template<typename T> inline T oro_cmpxchg(volatile void * ptr, T old, T _new)
 
 #pragma warning(pop)
 
+#define oro_rmb() MemoryBarrier()
+#define oro_wmb() MemoryBarrier()
+#define oro_mb() MemoryBarrier()
+
 #endif
@@ -99,6 +99,10 @@ __oro_cmpxchg(volatile void *ptr, unsigned long old, unsigned long newp, unsigne
 				    (unsigned long)_n_, sizeof(*(ptr))); \
   })
 
+#define oro_rmb() __asm__ __volatile__("sync": : :"memory")
+#define oro_wmb() __asm__ __volatile__("sync": : :"memory")
+#define oro_mb() __asm__ __volatile__("sync": : :"memory")
+
 #ifdef _cplusplus
 } // end extern "C"
 #endif // _cplusplus
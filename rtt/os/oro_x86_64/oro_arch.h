@@ -179,6 +179,12 @@ static inline unsigned long __oro_cmpxchg(volatile void *ptr, unsigned long old,
     ((__typeof__(*(ptr)))__oro_cmpxchg((ptr),(unsigned long)(o),\
                     (unsigned long)(n),sizeof(*(ptr))))
 
+/* loads are not reordered with other loads. */
+#define oro_rmb() __asm__ __volatile__("": : :"memory")
+/* stores are not reordered with other stores. */
+#define oro_wmb() __asm__ __volatile__("": : :"memory")
+#define oro_mb() __asm__ __volatile__("mfence": : :"memory")
+
 #undef ORO_LOCK_PREFIX
 #undef ORO_LOCK
 #endif
@@ -448,36 +448,32 @@ static char *mp = NULL;         /* Default memory pool. */
 static int  init_check = 0;          /* Init detection */
 
 /******************************************************************/
-size_t init_memory_pool(size_t mem_pool_size, void *mem_pool)
+static int check_memory_pool(size_t mem_pool_size, void *mem_pool)
 {
 /******************************************************************/
-    tlsf_t *tlsf;
-    bhdr_t *b, *ib;
-
     if (!mem_pool || !mem_pool_size || mem_pool_size < sizeof(tlsf_t) + BHDR_OVERHEAD * 8) {
         ERROR_MSG("init_memory_pool (): memory_pool invalid\n");
-        return -1;
+        return 0;
     }
 
     if (((unsigned long) mem_pool & PTR_MASK)) {
         ERROR_MSG("init_memory_pool (): mem_pool must be aligned to a word\n");
-        return -1;
-    }
-    tlsf = (tlsf_t *) mem_pool;
-    /* Check if already initialised */
-    if (init_check) {
-        mp = mem_pool;
-        b = GET_NEXT_BLOCK(mp, ROUNDUP_SIZE(sizeof(tlsf_t)));
-        return b->size & BLOCK_SIZE;
+        return 0;
     }
+    return 1;
+}
 
-    mp = mem_pool;
+/******************************************************************/
+static size_t setup_memory_pool(size_t mem_pool_size, void *mem_pool)
+{
+/******************************************************************/
+    tlsf_t *tlsf = (tlsf_t *) mem_pool;
+    bhdr_t *b, *ib;
 
     /* Zeroing the memory pool */
     memset(mem_pool, 0, sizeof(tlsf_t));
 
     tlsf->tlsf_signature = TLSF_SIGNATURE;
-    init_check = 1;
 
     TLSF_CREATE_LOCK(&tlsf->lock);
 
@@ -495,6 +491,40 @@ size_t init_memory_pool(size_t mem_pool_size, void *mem_pool)
     return (b->size & BLOCK_SIZE);
 }
 
+/******************************************************************/
+size_t init_memory_pool(size_t mem_pool_size, void *mem_pool)
+{
+/******************************************************************/
+    bhdr_t *b;
+
+    if (!check_memory_pool(mem_pool_size, mem_pool))
+        return -1;
+
+    /* Check if already initialised */
+    if (init_check) {
+        mp = mem_pool;
+        b = GET_NEXT_BLOCK(mp, ROUNDUP_SIZE(sizeof(tlsf_t)));
+        return b->size & BLOCK_SIZE;
+    }
+
+    mp = mem_pool;
+    init_check = 1;
+
+    return setup_memory_pool(mem_pool_size, mem_pool);
+}
+
+/******************************************************************/
+/* Orocos: initialises a pool for use with malloc_ex() and free_ex(),
+ * without making it the default pool. */
+size_t init_private_memory_pool(size_t mem_pool_size, void *mem_pool)
+{
+/******************************************************************/
+    if (!check_memory_pool(mem_pool_size, mem_pool))
+        return -1;
+
+    return setup_memory_pool(mem_pool_size, mem_pool);
+}
+
 /******************************************************************/
 size_t add_new_area(void *area, size_t area_size, void *mem_pool)
 {
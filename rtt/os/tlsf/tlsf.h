@@ -34,6 +34,7 @@ extern "C" {
 
 #ifdef ORO_MEMORY_POOL
 extern size_t init_memory_pool(size_t, void *);
+extern size_t init_private_memory_pool(size_t, void *);
 extern size_t get_used_size(void *);
 extern size_t get_used_size_mp();
 extern size_t get_max_size(void *);
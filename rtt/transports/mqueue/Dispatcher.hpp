@@ -44,6 +44,20 @@
 #include <map>
 #include <sys/select.h>
 #include <mqueue.h>
+#include <unistd.h>
+#include <errno.h>
+#ifdef OS_HAVE_EPOLL
+#include <sys/epoll.h>
+#endif
+
+/**
+ * The maximum number of message queues the Dispatcher
+ * handles at one wake-up. More ready queues are handled
+ * at the next wake-up.
+ */
+#ifndef ORONUM_MQ_DISPATCHER_EVENTS
+#define ORONUM_MQ_DISPATCHER_EVENTS 64
+#endif
 
 namespace RTT { namespace mqueue { class Dispatcher; } }
 
@@ -58,6 +72,11 @@ namespace RTT {
          * received new data.
          * Reasonably, there should be one dispatcher for each
          * peer component sending us data.
+         *
+         * On Linux, the queues are kept in an epoll set, which is updated
+         * by addQueue() and removeQueue(), such that a wake-up only costs
+         * in proportion to the number of queues with new data. Other
+         * systems use select().
          */
         class Dispatcher : public Activity
         {
@@ -73,19 +92,31 @@ namespace RTT {
 
             int highsock;        /* Highest #'d file descriptor, needed for select() */
 
+            int epollfd;         /* The epoll set of all queues, or -1 if select() is used */
+
             bool do_exit;
 
             os::Mutex maplock;
 
             Dispatcher( const std::string& name)
             : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
-              highsock(0), do_exit(false)
-              {}
+              highsock(0), epollfd(-1), do_exit(false)
+              {
+#ifdef OS_HAVE_EPOLL
+                  epollfd = epoll_create1(EPOLL_CLOEXEC);
+                  if (epollfd == -1) {
+                      Logger::In in("Dispatcher");
+                      log(Warning) << "Dispatcher could not create an epoll set, errno = " << errno << ". Using select()." <<endlog();
+                  }
+#endif
+              }
 
             ~Dispatcher() {
                 Logger::In in("Dispatcher");
                 log(Info) << "Dispacher cleans up: no more work."<<endlog();
                 stop();
+                if (epollfd != -1)
+                    close(epollfd);
                 DispatchI = 0;
             }
 
@@ -128,6 +159,30 @@ namespace RTT {
                 }
             }
 
+#ifdef OS_HAVE_EPOLL
+            /**
+             * Waits for the queues in the epoll set and signals
+             * all channels with new data at once.
+             * @return false if waiting failed.
+             */
+            bool wait_epoll() {
+                epoll_event events[ORONUM_MQ_DISPATCHER_EVENTS];
+                int ready = epoll_wait(epollfd, events, ORONUM_MQ_DISPATCHER_EVENTS, 50);
+                if (ready < 0)
+                    return errno == EINTR;
+                if (ready == 0)
+                    return true;
+                os::MutexLock lock(maplock);
+                for (int i = 0; i < ready; ++i) {
+                    // the queue may have been removed since epoll_wait() returned.
+                    MQMap::iterator it = mqmap.find( events[i].data.fd );
+                    if ( it != mqmap.end() )
+                        it->second->signal();
+                }
+                return true;
+            }
+#endif
+
         public:
             typedef boost::intrusive_ptr<Dispatcher> shared_ptr;
 
@@ -148,8 +203,20 @@ namespace RTT {
                 log(Debug) <<"Dispatcher is monitoring mqdes "<< mqdes <<endlog();
                 os::MutexLock lock(maplock);
                 // we add a refcount per channel we monitor.
-                if (mqmap.count(mqdes) == 0)
+                if (mqmap.count(mqdes) == 0) {
+#ifdef OS_HAVE_EPOLL
+                    if (epollfd != -1) {
+                        epoll_event event;
+                        event.events = EPOLLIN;
+                        event.data.fd = mqdes;
+                        if ( epoll_ctl(epollfd, EPOLL_CTL_ADD, mqdes, &event) == -1 ) {
+                            log(Error) <<"Dispatcher could not monitor mqdes "<< mqdes <<", errno = "<< errno <<endlog();
+                            return;
+                        }
+                    }
+#endif
                     refcount.inc();
+                }
                 mqmap[mqdes] = chan;
             }
 
@@ -158,6 +225,10 @@ namespace RTT {
                 log(Debug) <<"Dispatcher drops mqdes "<< mqdes <<endlog();
                 os::MutexLock lock(maplock);
                 if (mqmap.count(mqdes)) {
+#ifdef OS_HAVE_EPOLL
+                    if (epollfd != -1)
+                        epoll_ctl(epollfd, EPOLL_CTL_DEL, mqdes, 0);
+#endif
                     mqmap.erase( mqmap.find(mqdes) );
                     refcount.dec();
                 }
@@ -172,6 +243,17 @@ namespace RTT {
                 struct timeval timeout;  /* Timeout for select */
                 int readsocks;       /* Number of sockets ready for reading */
                 while (1) { /* select loop */
+#ifdef OS_HAVE_EPOLL
+                    if (epollfd != -1) {
+                        if ( !wait_epoll() ) {
+                            log(Error) <<"Dispatcher failed to wait on message queues. Stopped thread."<<endlog();
+                            return;
+                        }
+                        if ( do_exit )
+                            return;
+                        continue;
+                    }
+#endif
                     build_select_list();
                     timeout.tv_sec = 0;
                     timeout.tv_usec = 50000;
@@ -0,0 +1,220 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  MQBitwiseProtocol.hpp
+
+                        MQBitwiseProtocol.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_MQ_BITWISE_PROTOCOL_HPP
+#define ORO_MQ_BITWISE_PROTOCOL_HPP
+
+#include "MQTemplateProtocolBase.hpp"
+
+#include <boost/type_traits/is_pod.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <typeinfo>
+#include <cstring>
+#include <vector>
+
+namespace RTT
+{ namespace mqueue
+  {
+      /**
+       * Precedes the raw bytes of a sample in a message of the
+       * MQBitwiseProtocol, such that a receiver can detect that it was
+       * connected to a queue of another type.
+       */
+      struct MQBitwiseHeader
+      {
+          /** Hash of the mangled name of the sample type. */
+          boost::uint32_t type_hash;
+          /** The number of bytes following this header. */
+          boost::uint32_t size;
+
+          /**
+           * FNV-1a hash of the mangled name of \a T. The Itanium C++ ABI
+           * makes this equal for processes built by different compilers.
+           */
+          template<class T>
+          static boost::uint32_t hashOf() {
+              boost::uint32_t hash = 2166136261u;
+              for (const char* c = typeid(T).name(); *c; ++c)
+                  hash = (hash ^ (unsigned char)*c) * 16777619u;
+              return hash;
+          }
+
+          /**
+           * Checks the header of a received message.
+           * @return a pointer to the payload, or null if the message
+           * was not written for \a type_hash.
+           */
+          static const void* payload(const void* blob, int size, boost::uint32_t type_hash) {
+              const MQBitwiseHeader* header = (const MQBitwiseHeader*)blob;
+              if ( size < int(sizeof(MQBitwiseHeader)) || header->type_hash != type_hash
+                   || header->size != unsigned(size) - sizeof(MQBitwiseHeader) ) {
+                  log(Error) << "MQBitwiseProtocol: received a message of another type or size." << endlog();
+                  return 0;
+              }
+              return header + 1;
+          }
+      };
+
+      /**
+       * Transports flat types, which can be copied byte by byte,
+       * without constructing a boost::serialization archive. Each message
+       * holds an MQBitwiseHeader followed by the bytes of the sample.
+       *
+       * Use this instead of MQSerializationProtocol for structs of
+       * primitive types and fixed size arrays. Pointers, std::string
+       * and other containers can not be transported this way, except
+       * for std::vector of such a flat type, which is specialised below.
+       *
+       * The messages are not compatible with those of
+       * MQSerializationProtocol, so register it under another protocol id
+       * than an existing MQSerializationProtocol of the same type, such as
+       * ORO_MQUEUE_BITWISE_PROTOCOL_ID, and let both ends of a connection
+       * select it with ConnPolicy::transport.
+       */
+      template<class T>
+      class MQBitwiseProtocol
+          : public MQTemplateProtocolBase<T>
+      {
+          boost::uint32_t mtype_hash;
+      public:
+          /**
+           * Only types which can be copied byte by byte between
+           * processes are supported: no pointers, no virtual functions.
+           */
+          BOOST_STATIC_ASSERT( boost::is_pod<T>::value );
+
+          typedef T UserType;
+
+          MQBitwiseProtocol() : mtype_hash( MQBitwiseHeader::hashOf<T>() ) {}
+
+          virtual std::pair<void const*,int> fillBlob( base::DataSourceBase::shared_ptr source, void* blob, int size, void* cookie) const
+          {
+              typename internal::DataSource<T>::shared_ptr d = internal::DataSource<T>::narrow( source.get() );
+              if ( d && sizeof(MQBitwiseHeader) + sizeof(T) <= (unsigned int)size ) {
+                  MQBitwiseHeader* header = (MQBitwiseHeader*)blob;
+                  header->type_hash = mtype_hash;
+                  header->size = sizeof(T);
+                  memcpy( header + 1, &d->rvalue(), sizeof(T) );
+                  return std::make_pair((void const*)blob, int(sizeof(MQBitwiseHeader) + sizeof(T)));
+              }
+              return std::make_pair((void const*)0,int(0));
+          }
+
+          virtual bool updateFromBlob(const void* blob, int size, base::DataSourceBase::shared_ptr target, void* cookie) const
+          {
+              typename internal::AssignableDataSource<T>::shared_ptr ad = internal::AssignableDataSource<T>::narrow( target.get() );
+              const void* payload = MQBitwiseHeader::payload(blob, size, mtype_hash);
+              if ( ad && payload && size - sizeof(MQBitwiseHeader) == sizeof(T) ) {
+                  memcpy( &ad->set(), payload, sizeof(T) );
+                  return true;
+              }
+              return false;
+          }
+
+          virtual unsigned int getSampleSize(base::DataSourceBase::shared_ptr ignored, void* cookie) const
+          {
+              return sizeof(MQBitwiseHeader) + sizeof(T);
+          }
+      };
+
+      /**
+       * Transports a std::vector of a flat type as its elements.
+       * A receiving vector is only reallocated if its capacity is
+       * too small.
+       */
+      template<class T>
+      class MQBitwiseProtocol< std::vector<T> >
+          : public MQTemplateProtocolBase< std::vector<T> >
+      {
+          boost::uint32_t mtype_hash;
+      public:
+          /**
+           * The elements must be copyable byte by byte.
+           */
+          BOOST_STATIC_ASSERT( boost::is_pod<T>::value );
+
+          typedef std::vector<T> UserType;
+
+          MQBitwiseProtocol() : mtype_hash( MQBitwiseHeader::hashOf<UserType>() ) {}
+
+          virtual std::pair<void const*,int> fillBlob( base::DataSourceBase::shared_ptr source, void* blob, int size, void* cookie) const
+          {
+              typename internal::DataSource<UserType>::shared_ptr d = internal::DataSource<UserType>::narrow( source.get() );
+              if ( !d )
+                  return std::make_pair((void const*)0,int(0));
+              UserType const& vec = d->rvalue();
+              unsigned int bytes = vec.size() * sizeof(T);
+              if ( sizeof(MQBitwiseHeader) + bytes > (unsigned int)size )
+                  return std::make_pair((void const*)0,int(0));
+              MQBitwiseHeader* header = (MQBitwiseHeader*)blob;
+              header->type_hash = mtype_hash;
+              header->size = bytes;
+              if ( bytes )
+                  memcpy( header + 1, &vec[0], bytes );
+              return std::make_pair((void const*)blob, int(sizeof(MQBitwiseHeader) + bytes));
+          }
+
+          virtual bool updateFromBlob(const void* blob, int size, base::DataSourceBase::shared_ptr target, void* cookie) const
+          {
+              typename internal::AssignableDataSource<UserType>::shared_ptr ad = internal::AssignableDataSource<UserType>::narrow( target.get() );
+              const void* payload = MQBitwiseHeader::payload(blob, size, mtype_hash);
+              if ( ad && payload && (size - sizeof(MQBitwiseHeader)) % sizeof(T) == 0 ) {
+                  UserType& vec = ad->set();
+                  vec.resize( (size - sizeof(MQBitwiseHeader)) / sizeof(T) );
+                  if ( !vec.empty() )
+                      memcpy( &vec[0], payload, vec.size() * sizeof(T) );
+                  return true;
+              }
+              return false;
+          }
+
+          virtual unsigned int getSampleSize(base::DataSourceBase::shared_ptr sample, void* cookie) const
+          {
+              typename internal::DataSource<UserType>::shared_ptr d = internal::DataSource<UserType>::narrow( sample.get() );
+              if ( !d ) {
+                  log(Error) << "getSampleSize: sample has wrong type."<<endlog();
+                  return 0;
+              }
+              return sizeof(MQBitwiseHeader) + d->get().size() * sizeof(T);
+          }
+      };
+}
+}
+
+#endif
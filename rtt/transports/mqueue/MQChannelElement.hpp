@@ -92,6 +92,9 @@ namespace RTT
                         this->getOutput();
                     assert(output);
                     output->data_sample(read_sample->rvalue());
+                    // forward the rest of a batched message.
+                    while ( mqPending() && mqRead(read_sample) )
+                        output->write(read_sample->rvalue());
                     return true;
                 }
                 return false;
@@ -125,6 +128,8 @@ namespace RTT
              *
              * In the sending case, signal could trigger a dispatcher thread
              * that does the read/write cycle, but that seems only causing overhead.
+             * Only a batching sender (ConnPolicy::batch_size > 1) does so, since
+             * its thread can pack all samples written in the meantime.
              * The receiving case must use a thread which blocks on all mq
              * file descriptors.
              * @return true in case the forwarding could be done, false otherwise.
@@ -133,6 +138,9 @@ namespace RTT
             {
                 // copy messages into channel
                 if (mis_sender) {
+                    // a batching sender packs the samples in its own thread.
+                    if ( mqBatching() )
+                        return mqTrigger();
                     // this read should always succeed since signal() means
                     // 'data available in a data element'.
                     typename base::ChannelElement<T>::shared_ptr input =
@@ -142,12 +150,32 @@ namespace RTT
                 } else {
                     typename base::ChannelElement<T>::shared_ptr output =
                         this->getOutput();
-                    if (output && mqRead(read_sample))
-                        return output->write(read_sample->rvalue());
+                    if (output && mqRead(read_sample)) {
+                        bool result = output->write(read_sample->rvalue());
+                        // a batched message holds more samples.
+                        while ( mqPending() && mqRead(read_sample) )
+                            result = output->write(read_sample->rvalue()) && result;
+                        return result;
+                    }
                 }
                 return false;
             }
 
+            /**
+             * Packs all samples of the input in as few messages as
+             * possible. Called by the thread of a batching sender.
+             */
+            void mqSendPending()
+            {
+                typename base::ChannelElement<T>::shared_ptr input =
+                    this->getInput();
+                if ( !input )
+                    return;
+                while ( input->read(read_sample->set(), false) == NewData )
+                    mqWriteBatch(read_sample);
+                mqEndBatch();
+            }
+
             /**
              * Read from the message queue.
              * @param sample stores the resulting data sample.
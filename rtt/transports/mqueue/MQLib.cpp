@@ -40,6 +40,7 @@
 #include "MQLib.hpp"
 #include "MQTemplateProtocol.hpp"
 #include "MQSerializationProtocol.hpp"
+#include "MQBitwiseProtocol.hpp"
 #include "../../types/TransportPlugin.hpp"
 #include "../../types/TypekitPlugin.hpp"
 #include <boost/serialization/vector.hpp>
@@ -70,7 +71,9 @@ namespace RTT {
             if ( name == "bool" )
                 return ti->addProtocol(ORO_MQUEUE_PROTOCOL_ID, new MQTemplateProtocol<bool>() );
             if ( name == "array" )
-                return ti->addProtocol(ORO_MQUEUE_PROTOCOL_ID, new MQSerializationProtocol< std::vector<double> >() );
+                // the bitwise messages are opt-in, to remain compatible with peers using serialization.
+                return ti->addProtocol(ORO_MQUEUE_PROTOCOL_ID, new MQSerializationProtocol< std::vector<double> >() )
+                    && ti->addProtocol(ORO_MQUEUE_BITWISE_PROTOCOL_ID, new MQBitwiseProtocol< std::vector<double> >() );
             //if ( name == "void" )
             //    return ti->addProtocol(ORO_MQUEUE_PROTOCOL_ID, new MQFallBackProtocol(false)); // warn=false
             return false;
@@ -55,4 +55,11 @@ namespace RTT {
 }
 
 #define ORO_MQUEUE_PROTOCOL_ID 2
+
+/**
+ * The mqueue transport with MQBitwiseProtocol, which the 'array' type
+ * offers next to its ORO_MQUEUE_PROTOCOL_ID. Both ends of a connection
+ * must use the same id, since the messages of both are not compatible.
+ */
+#define ORO_MQUEUE_BITWISE_PROTOCOL_ID 5
 #endif
@@ -54,14 +54,68 @@
 #include "../../base/PortInterface.hpp"
 #include "../../DataFlowInterface.hpp"
 #include "../../TaskContext.hpp"
+#include "../../Activity.hpp"
+#include "../../base/RunnableInterface.hpp"
+#include "../../os/MutexLock.hpp"
+#include "../../os/oro_malloc.h"
+#include <boost/cstdint.hpp>
+#include <algorithm>
 
 using namespace RTT;
 using namespace RTT::detail;
 using namespace RTT::mqueue;
 
+namespace RTT
+{
+    namespace mqueue
+    {
+        /**
+         * Lets the thread of a batching sender send the pending samples.
+         */
+        class MQBatchRunner : public base::RunnableInterface
+        {
+            MQSendRecv* mq;
+        public:
+            MQBatchRunner(MQSendRecv* mq) : mq(mq) {}
+            bool initialize() { return true; }
+            void step() { mq->mqSendPending(); }
+            void finalize() {}
+        };
+    }
+}
+
+namespace
+{
+    /**
+     * Starts a batched message.
+     */
+    struct MQBatchHeader
+    {
+        boost::uint32_t frames;
+        boost::uint32_t reserved;
+    };
+
+    /**
+     * Precedes each sample in a batched message. The next
+     * frame starts at the next multiple of 8 bytes.
+     */
+    struct MQFrameHeader
+    {
+        boost::uint32_t size;
+        boost::uint32_t reserved;
+    };
+
+    int frameSpace(int size)
+    {
+        return sizeof(MQFrameHeader) + ((size + 7) & ~7);
+    }
+}
+
 
 MQSendRecv::MQSendRecv(types::TypeMarshaller const& transport) :
-    mtransport(transport), marshaller_cookie(0), buf(0), mis_sender(false), minit_done(false), max_size(0), mdata_size(0)
+    mtransport(transport), marshaller_cookie(0), buf(0), mis_sender(false), minit_done(false), max_size(0), mdata_size(0),
+    mbatch_size(0), mmsg_size(0), mbatch_buf(0), mbatch_bytes(0), mbatch_sender(0), mbatch_runner(0),
+    mframe_offset(0), mframes_left(0), mframe_end(0), mhigh_water(0)
 {
 }
 
@@ -70,10 +124,14 @@ void MQSendRecv::setupStream(base::DataSourceBase::shared_ptr ds, base::PortInte
 {
     Logger::In in("MQSendRecv");
 
+    // the queue must take the largest sample, but the sender starts
+    // with a buffer for the current one.
     mdata_size = policy.data_size;
-    max_size = policy.data_size ? policy.data_size : mtransport.getSampleSize(ds);
+    int sample_size = mtransport.getSampleSize(ds);
+    max_size = std::max(mdata_size, sample_size);
     marshaller_cookie = mtransport.createCookie();
     mis_sender = is_sender;
+    mbatch_size = policy.batch_size;
 
     std::stringstream namestr;
     namestr << '/' << port->getInterface()->getOwner()->getName() << '.' << port->getName() << '.' << this << '@' << getpid();
@@ -84,6 +142,8 @@ void MQSendRecv::setupStream(base::DataSourceBase::shared_ptr ds, base::PortInte
     struct mq_attr mattr;
     mattr.mq_maxmsg = policy.size ? policy.size : 10;
     mattr.mq_msgsize = max_size;
+    if (mbatch_size > 1)
+        mattr.mq_msgsize = sizeof(MQBatchHeader) + mbatch_size * frameSpace(max_size);
     assert( max_size );
     if (policy.name_id[0] != '/')
         throw std::runtime_error("Could not open message queue with wrong name. Names must start with '/' and contain no more '/' after the first one.");
@@ -138,9 +198,27 @@ void MQSendRecv::setupStream(base::DataSourceBase::shared_ptr ds, base::PortInte
 
     log(Debug) << "Opened '" << policy.name_id << "' with mqdes='" << mqdes << "', msg size='"<<mattr.mq_msgsize<<"' an queue length='"<<mattr.mq_maxmsg<<"' for " << (is_sender ? "writing." : "reading.") << endlog();
 
-    buf = new char[max_size];
-    memset(buf, 0, max_size); // necessary to trick valgrind
+    // the queue may exist already with another message size.
+    struct mq_attr qattr;
+    mmsg_size = mq_getattr(mqdes, &qattr) == 0 ? qattr.mq_msgsize : mattr.mq_msgsize;
     mqname = policy.name_id;
+    mhigh_water = 0;
+
+    // a receiver must accept any message of the queue.
+    if ( !mqResize( is_sender && sample_size > 0 ? std::min(sample_size, mmsg_size) : mmsg_size ) )
+    {
+        mq_close(mqdes);
+        throw std::runtime_error("Could not allocate the message queue buffer.");
+    }
+
+    if ( mqBatching() )
+    {
+        mbatch_buf = new char[mmsg_size];
+        memset(mbatch_buf, 0, mmsg_size);
+        mbatch_runner = new MQBatchRunner(this);
+        mbatch_sender = new Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, mbatch_runner, "MQBatchSender");
+        mbatch_sender->start();
+    }
 }
 
 MQSendRecv::~MQSendRecv()
@@ -151,6 +229,16 @@ MQSendRecv::~MQSendRecv()
 
 void MQSendRecv::cleanupStream()
 {
+    if (mbatch_sender)
+    {
+        mbatch_sender->stop();
+        delete mbatch_sender;
+        delete mbatch_runner;
+        delete[] mbatch_buf;
+        mbatch_sender = 0;
+        mbatch_runner = 0;
+        mbatch_buf = 0;
+    }
     if (!mis_sender)
     {
         if (minit_done)
@@ -172,20 +260,48 @@ void MQSendRecv::cleanupStream()
 
     if (buf)
     {
-        delete[] buf;
+        oro_rt_free(buf);
         buf = 0;
     }
+    log(Debug) << "MQChannel '" << mqname << "' used at most " << mhigh_water << " bytes of a message size of " << mmsg_size << " bytes." << endlog();
 }
 
 
 void MQSendRecv::mqNewSample(RTT::base::DataSourceBase::shared_ptr ds)
 {
-    // only deduce if user did not specify it explicitly:
-    if (mdata_size == 0)
-        max_size = mtransport.getSampleSize(ds);
-    delete[] buf;
-    buf = new char[max_size];
-    memset(buf, 0, max_size); // necessary to trick valgrind
+    int size = mtransport.getSampleSize(ds);
+    if (size > max_size)
+        mqReserve(size);
+    else if (size > 0 && size * 4 < max_size)
+        mqResize(size);
+}
+
+bool MQSendRecv::mqReserve(int size)
+{
+    if (size <= max_size)
+        return true;
+    if (size > mmsg_size)
+    {
+        log(Error) << "MQChannel '" << mqname << "': sample of " << size << " bytes does not fit in a message of " << mmsg_size << " bytes." << endlog();
+        return false;
+    }
+    return mqResize( std::min( std::max(size, max_size + max_size / 2), mmsg_size ) );
+}
+
+bool MQSendRecv::mqResize(int size)
+{
+    char* nbuf = (char*) oro_rt_malloc(size);
+    if (nbuf == 0)
+    {
+        log(Error) << "MQChannel '" << mqname << "': could not allocate " << size << " bytes." << endlog();
+        return false;
+    }
+    memset(nbuf, 0, size); // necessary to trick valgrind
+    if (buf)
+        oro_rt_free(buf);
+    buf = nbuf;
+    max_size = size;
+    return true;
 }
 
 bool MQSendRecv::mqReady(base::DataSourceBase::shared_ptr ds, base::ChannelElementBase* chan)
@@ -205,10 +321,12 @@ bool MQSendRecv::mqReady(base::DataSourceBase::shared_ptr ds, base::ChannelEleme
         abs_timeout.tv_sec += abs_timeout.tv_nsec / (1000*1000*1000);
         abs_timeout.tv_nsec = abs_timeout.tv_nsec % (1000*1000*1000);
         //abs_timeout.tv_sec +=1;
-        ssize_t ret = mq_timedreceive(mqdes, buf, max_size, 0, &abs_timeout);
+        unsigned int prio = 0;
+        ssize_t ret = mq_timedreceive(mqdes, buf, max_size, &prio, &abs_timeout);
         if (ret != -1)
         {
-            if (mtransport.updateFromBlob((void*) buf, ret, ds, marshaller_cookie))
+            mhigh_water = std::max(mhigh_water, int(ret));
+            if (mqUnpack(ds, ret, prio))
             {
                 minit_done = true;
                 // ok, now we can add the dispatcher.
@@ -238,28 +356,146 @@ bool MQSendRecv::mqReady(base::DataSourceBase::shared_ptr ds, base::ChannelEleme
 
 bool MQSendRecv::mqRead(RTT::base::DataSourceBase::shared_ptr ds)
 {
+    if (mframes_left > 0)
+        return mqNextFrame(ds);
+
     int bytes = 0;
-    if ((bytes = mq_receive(mqdes, buf, max_size, 0)) == -1)
+    unsigned int prio = 0;
+    if ((bytes = mq_receive(mqdes, buf, max_size, &prio)) == -1)
     {
         //log(Debug) << "Tried read on empty mq!" <<endlog();
         return false;
     }
-    if (mtransport.updateFromBlob((void*) buf, bytes, ds, marshaller_cookie))
+    mhigh_water = std::max(mhigh_water, bytes);
+    return mqUnpack(ds, bytes, prio);
+}
+
+bool MQSendRecv::mqUnpack(RTT::base::DataSourceBase::shared_ptr ds, int bytes, unsigned int prio)
+{
+    mframes_left = 0;
+    if (prio != BatchPriority)
+        return mtransport.updateFromBlob((void*) buf, bytes, ds, marshaller_cookie);
+
+    if (bytes < (int) sizeof(MQBatchHeader))
+        return false;
+    mframes_left = ((MQBatchHeader*) buf)->frames;
+    mframe_offset = sizeof(MQBatchHeader);
+    mframe_end = bytes;
+    return mqNextFrame(ds);
+}
+
+bool MQSendRecv::mqNextFrame(RTT::base::DataSourceBase::shared_ptr ds)
+{
+    MQFrameHeader* frame = (MQFrameHeader*) (buf + mframe_offset);
+    if (mframes_left <= 0 || mframe_offset + (int) sizeof(MQFrameHeader) > mframe_end
+        || mframe_offset + (int) sizeof(MQFrameHeader) + (int) frame->size > mframe_end)
+    {
+        if (mframes_left > 0)
+            log(Error) << "MQChannel "<< mqdes << " received a truncated batch." << endlog();
+        mframes_left = 0;
+        return false;
+    }
+    --mframes_left;
+    mframe_offset += frameSpace(frame->size);
+    return mtransport.updateFromBlob((void*) (frame + 1), frame->size, ds, marshaller_cookie);
+}
+
+bool MQSendRecv::mqPack(RTT::base::DataSourceBase::shared_ptr ds)
+{
+    for (int attempt = 0; attempt != 2; ++attempt)
     {
-        return true;
+        if (mbatch_bytes == 0)
+        {
+            ((MQBatchHeader*) mbatch_buf)->frames = 0;
+            mbatch_bytes = sizeof(MQBatchHeader);
+        }
+        MQBatchHeader* header = (MQBatchHeader*) mbatch_buf;
+        char* frame = mbatch_buf + mbatch_bytes;
+        int space = mmsg_size - mbatch_bytes - (int) sizeof(MQFrameHeader);
+        if ((int) header->frames < mbatch_size && space > 0)
+        {
+            std::pair<void const*, int> blob = mtransport.fillBlob(ds, frame + sizeof(MQFrameHeader), space, marshaller_cookie);
+            if (blob.first != 0 && blob.second <= space)
+            {
+                if (blob.first != frame + sizeof(MQFrameHeader))
+                    memcpy(frame + sizeof(MQFrameHeader), blob.first, blob.second);
+                ((MQFrameHeader*) frame)->size = blob.second;
+                mbatch_bytes = std::min(mbatch_bytes + frameSpace(blob.second), mmsg_size);
+                header->frames += 1;
+                return true;
+            }
+        }
+        // the message is full: send it and retry in an empty one.
+        if (header->frames == 0 || !mqFlush())
+            break;
     }
+    log(Error) << "MQChannel: failed to marshal sample in message of " << mmsg_size << " bytes" << endlog();
     return false;
 }
 
+bool MQSendRecv::mqFlush()
+{
+    if (mbatch_bytes == 0)
+        return true;
+    int bytes = mbatch_bytes;
+    mbatch_bytes = 0;
+    mhigh_water = std::max(mhigh_water, bytes);
+    if (mq_send(mqdes, mbatch_buf, bytes, BatchPriority) == -1)
+    {
+        if (errno == EAGAIN)
+            return true;
+
+        log(Error) << "MQChannel "<< mqdes << " became invalid (mq length="<<mmsg_size<<", msg length="<<bytes<<"): " << strerror(errno) << endlog();
+        return false;
+    }
+    return true;
+}
+
+bool MQSendRecv::mqTrigger()
+{
+    return mbatch_sender && mbatch_sender->trigger();
+}
+
+void MQSendRecv::mqSendPending()
+{
+}
+
+bool MQSendRecv::mqWriteBatch(RTT::base::DataSourceBase::shared_ptr ds)
+{
+    os::MutexLock lock(mbatch_lock);
+    return mqPack(ds);
+}
+
+bool MQSendRecv::mqEndBatch()
+{
+    os::MutexLock lock(mbatch_lock);
+    return mqFlush();
+}
+
 bool MQSendRecv::mqWrite(RTT::base::DataSourceBase::shared_ptr ds)
 {
+    if ( mqBatching() )
+    {
+        os::MutexLock lock(mbatch_lock);
+        return mqPack(ds) && mqFlush();
+    }
+
     std::pair<void const*, int> blob = mtransport.fillBlob(ds, buf, max_size, marshaller_cookie);
+    if (blob.first == 0 || (blob.first == buf && blob.second > max_size))
+    {
+        // the sample outgrew buf.
+        if ( mqReserve( mtransport.getSampleSize(ds, marshaller_cookie) ) )
+            blob = mtransport.fillBlob(ds, buf, max_size, marshaller_cookie);
+        else
+            blob.first = 0;
+    }
     if (blob.first == 0)
     {
         log(Error) << "MQChannel: failed to marshal sample" << endlog();
         return false;
     }
 
+    mhigh_water = std::max(mhigh_water, blob.second);
     char* lbuf = (char*) blob.first;
     if (mq_send(mqdes, lbuf, blob.second, 0) == -1)
     {
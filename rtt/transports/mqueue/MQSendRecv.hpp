@@ -42,17 +42,42 @@
 #include <mqueue.h>
 #include "../../rtt-fwd.hpp"
 #include "../../base/DataSourceBase.hpp"
+#include "../../os/Mutex.hpp"
 
 namespace RTT
 {
     namespace mqueue
     {
+        class MQBatchRunner;
+
         /**
          * Implements the sending/receiving of mqueue messages.
          * It can only be OR sender OR receiver (logical XOR).
+         *
+         * If ConnPolicy::batch_size is larger than one, the sender packs
+         * up to that many samples in one message, as long as they fit in
+         * the message size of the queue. Such a message starts with the
+         * number of frames, followed by each marshalled sample and its
+         * size. Batched messages are sent with priority BatchPriority,
+         * such that receivers recognise them without any configuration.
+         *
+         * The message size of the queue is ConnPolicy::data_size, in bytes,
+         * or the size of the initial sample if that is larger. Set data_size
+         * to the size of the largest sample for variable-length types, such
+         * as sequences which grow. The send buffer starts at the size of the
+         * initial sample and grows and shrinks with the samples, up to the
+         * message size of the queue.
          */
         class MQSendRecv
         {
+        public:
+            /**
+             * The mq_send priority of batched messages. A sender sends
+             * all its messages with the same priority, which keeps them
+             * in order.
+             */
+            static const unsigned int BatchPriority = 1;
+
         protected:
             /**
              * Transport marshaller used for size calculations
@@ -70,9 +95,11 @@ namespace RTT
              */
             mqd_t mqdes;
             /**
-             * Send/Receive buffer. It is initialized to the size of the value
-             * provided by the ConnPolicy or, if the policy has a zero data
-             * size, the sample given to setupStream
+             * Send/Receive buffer. It is initialized to the size of the
+             * sample given to setupStream, except on the receiving
+             * side, which must be able to receive a message of mmsg_size.
+             * It is allocated with oro_rt_malloc() and grows in the write path
+             * when a sample does not fit, but never beyond mmsg_size.
              *
              * Its size is saved in max_size
              */
@@ -95,11 +122,87 @@ namespace RTT
              */
             std::string mqname;
             /**
-             * The size of the data, as specified in the ConnPolicy when
-             * creating the stream, or calculated using the transport when
-             * that size was zero.
+             * The maximum size of the data, as specified in the ConnPolicy
+             * when creating the stream, or zero.
              */
             int mdata_size;
+            /**
+             * The maximum number of samples in one message, zero or one if not batching.
+             */
+            int mbatch_size;
+            /**
+             * The message size of the queue, which may differ from max_size
+             * if the other side created the queue.
+             */
+            int mmsg_size;
+            /**
+             * The message being packed by a batching sender, of mmsg_size.
+             */
+            char* mbatch_buf;
+            /**
+             * The number of bytes used in mbatch_buf.
+             */
+            int mbatch_bytes;
+            /**
+             * Protects mbatch_buf.
+             */
+            os::Mutex mbatch_lock;
+            /**
+             * The thread and runnable which send the pending samples of a batching sender.
+             */
+            base::ActivityInterface* mbatch_sender;
+            MQBatchRunner* mbatch_runner;
+            /**
+             * The offset in buf of the next frame of a received batched message
+             * and the number of frames left in it.
+             */
+            int mframe_offset;
+            int mframes_left;
+            /**
+             * The size of the received batched message in buf.
+             */
+            int mframe_end;
+            /**
+             * The largest message sent or received on this connection.
+             */
+            int mhigh_water;
+
+            /**
+             * Makes buf at least \a size bytes large. It grows by at least half
+             * its size, such that a growing sample does not reallocate
+             * on every write, and never beyond mmsg_size.
+             * @return false if \a size is larger than mmsg_size or if no
+             * memory is available.
+             */
+            bool mqReserve(int size);
+
+            /**
+             * Replaces buf by a buffer of \a size bytes.
+             */
+            bool mqResize(int size);
+
+            /**
+             * Unmarshals the first sample of a message of \a bytes bytes in buf,
+             * which was received with priority \a prio.
+             */
+            bool mqUnpack(base::DataSourceBase::shared_ptr ds, int bytes, unsigned int prio);
+
+            /**
+             * Unmarshals the next frame of a batched message in buf.
+             */
+            bool mqNextFrame(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Appends a sample to mbatch_buf. The caller must hold mbatch_lock.
+             * Sends mbatch_buf first if the sample does not fit or if it holds
+             * mbatch_size samples.
+             */
+            bool mqPack(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Sends mbatch_buf, if it holds any sample. The caller must hold mbatch_lock.
+             */
+            bool mqFlush();
 
         public:
             /**
@@ -115,9 +218,10 @@ namespace RTT
             void cleanupStream();
 
             /**
-             * Adapts the mq send/receive buffer size according to the
-             * data in mqdata_source, or the value set in mdata_size;
-             * @param sample
+             * Adapts the mq send buffer size according to the
+             * data in \a ds, up to the message size of the queue.
+             * The buffer only shrinks if less than a quarter of it is used.
+             * @param ds The new sample.
              */
             virtual void mqNewSample(base::DataSourceBase::shared_ptr ds);
 
@@ -142,6 +246,46 @@ namespace RTT
              * @return true if it could be sent.
              */
             bool mqWrite(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Returns the size of the largest message which was sent or received
+             * on this connection. It is logged when the stream is cleaned up.
+             */
+            int mqHighWater() const { return mhigh_water; }
+
+            /**
+             * Returns true if a received batched message holds
+             * samples which were not read yet.
+             */
+            bool mqPending() const { return mframes_left > 0; }
+
+            /**
+             * Returns true if this is a sender which batches samples.
+             */
+            bool mqBatching() const { return mis_sender && mbatch_size > 1; }
+
+            /**
+             * Wakes up the thread of a batching sender, which calls mqSendPending().
+             */
+            bool mqTrigger();
+
+            /**
+             * Called in the thread of a batching sender to send all pending
+             * samples with mqWriteBatch(). The default does nothing.
+             */
+            virtual void mqSendPending();
+
+            /**
+             * Packs a sample into the current batch. Call mqEndBatch()
+             * after the last sample to send it.
+             * @return true if it could be packed.
+             */
+            bool mqWriteBatch(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Sends the current batch.
+             */
+            bool mqEndBatch();
         };
     }
 }
@@ -84,6 +84,11 @@
 #include <boost/serialization/item_version_type.hpp>
 #endif
 
+// BOOST_PFTO was removed from Boost 1.59
+#ifndef BOOST_PFTO
+#define BOOST_PFTO
+#endif
+
 namespace RTT
 {
     namespace mqueue
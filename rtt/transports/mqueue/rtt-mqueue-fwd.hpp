@@ -8,6 +8,8 @@ namespace RTT {
         class MQSerializationProtocol;
         template<class T>
         class MQTemplateProtocol;
+        template<class T>
+        class MQBitwiseProtocol;
         template<typename T>
         class MQChannelElement;
     }
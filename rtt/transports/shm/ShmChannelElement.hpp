@@ -0,0 +1,160 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ShmChannelElement.hpp
+
+                        ShmChannelElement.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef SHM_CHANNEL_ELEMENT_H
+#define SHM_CHANNEL_ELEMENT_H
+
+#include "ShmSendRecv.hpp"
+#include "../../Logger.hpp"
+#include "../../base/ChannelElement.hpp"
+#include "../../internal/DataSource.hpp"
+#include "../../internal/DataSources.hpp"
+#include <stdexcept>
+
+namespace RTT
+{
+    namespace shm
+    {
+        /**
+         * Implements a ChannelElement using a shared memory ring buffer.
+         * It converts the C++ calls into ring buffer slots and vice versa.
+         */
+        template<typename T>
+        class ShmChannelElement: public base::ChannelElement<T>, public ShmSendRecv
+        {
+            /** Used as a temporary on the reading side */
+            typename internal::ValueDataSource<T>::shared_ptr read_sample;
+            /** Used in write() to refer to the sample that needs to be written */
+            typename internal::LateConstReferenceDataSource<T>::shared_ptr write_sample;
+
+        public:
+            /**
+             * Create a channel element for remote data exchange.
+             * @param transport The type specific object that will be used to marshal the data.
+             */
+            ShmChannelElement(base::PortInterface* port, types::TypeMarshaller const& transport,
+                              const ConnPolicy& policy, bool is_sender)
+                : ShmSendRecv(transport)
+                , read_sample(new internal::ValueDataSource<T>)
+                , write_sample(new internal::LateConstReferenceDataSource<T>)
+
+            {
+                Logger::In in("ShmChannelElement");
+                setupStream(read_sample, port, policy, is_sender);
+            }
+
+            ~ShmChannelElement() {
+                cleanupStream();
+            }
+
+            virtual bool inputReady() {
+                if ( shmReady(read_sample, this) ) {
+                    typename base::ChannelElement<T>::shared_ptr output =
+                        this->getOutput();
+                    assert(output);
+                    output->data_sample(read_sample->rvalue());
+                    return true;
+                }
+                return false;
+            }
+
+            virtual bool data_sample(typename base::ChannelElement<T>::param_t sample)
+            {
+                // send initial data sample to the other side using a plain write.
+                if (mis_sender) {
+                    write_sample->setPointer(&sample);
+                    return shmWrite(write_sample);
+                }
+                return false;
+            }
+
+            /**
+             * Signal will cause a read-write cycle to transfer the
+             * data from the data/buffer element to the ring buffer
+             * and vice versa.
+             *
+             * For a sending element, signal triggers a direct read on
+             * the data element. For a receiving element, signal is used
+             * by the ShmReader thread to read a sample from the ring and
+             * forward it to the next channel element.
+             * @return true in case the forwarding could be done, false otherwise.
+             */
+            bool signal()
+            {
+                if (mis_sender) {
+                    // this read should always succeed since signal() means
+                    // 'data available in a data element'.
+                    typename base::ChannelElement<T>::shared_ptr input =
+                        this->getInput();
+                    if( input && input->read(read_sample->set(), false) == NewData )
+                        return this->write(read_sample->rvalue());
+                } else {
+                    // always consume the slot, such that the ring does
+                    // not stay full when there is no output (yet).
+                    typename base::ChannelElement<T>::shared_ptr output =
+                        this->getOutput();
+                    if (shmRead(read_sample) && output)
+                        return output->write(read_sample->rvalue());
+                }
+                return false;
+            }
+
+            /**
+             * Reading is done by the ShmReader thread.
+             */
+            FlowStatus read(typename base::ChannelElement<T>::reference_t sample, bool copy_old_data)
+            {
+                throw std::runtime_error("not implemented");
+            }
+
+            /**
+             * Write to the ring buffer
+             * @param sample the data sample to write
+             * @return true if it could be sent.
+             */
+            bool write(typename base::ChannelElement<T>::param_t sample)
+            {
+                write_sample->setPointer(&sample);
+                return shmWrite(write_sample);
+            }
+
+        };
+    }
+}
+
+#endif
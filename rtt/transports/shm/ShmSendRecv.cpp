@@ -0,0 +1,415 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ShmSendRecv.cpp
+
+                        ShmSendRecv.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#include <sstream>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <errno.h>
+
+#include "ShmSendRecv.hpp"
+#include "../../types/TypeMarshaller.hpp"
+#include "../../Logger.hpp"
+#include "../../Activity.hpp"
+#include "../../base/ChannelElementBase.hpp"
+#include "../../base/PortInterface.hpp"
+#include "../../DataFlowInterface.hpp"
+#include "../../TaskContext.hpp"
+#include "../../os/oro_arch.h"
+#include "../../os/TimeService.hpp"
+
+using namespace RTT;
+using namespace RTT::detail;
+using namespace RTT::shm;
+
+/**
+ * Written last by the creator of a shared memory object,
+ * such that others know the ring is initialised.
+ */
+#define ORO_SHM_MAGIC 0x4f52534d
+
+namespace RTT
+{
+    namespace shm
+    {
+        /**
+         * The layout of the start of a shared memory object. The slots
+         * follow at data_offset, each one stride bytes large.
+         *
+         * head and seq are only written by the sender, tail and waiters
+         * only by the receiver, so each pair has a cache line of its own.
+         * head and tail are free running counters.
+         */
+        struct ShmRingHeader
+        {
+            int volatile magic;
+            unsigned int slots;
+            unsigned int slot_size;
+            unsigned int stride;
+            unsigned int data_offset;
+            ORO_CACHE_LINE_ALIGNED unsigned int volatile head;
+            /** The futex word, incremented after each write. */
+            oro_atomic_t seq;
+            ORO_CACHE_LINE_ALIGNED unsigned int volatile tail;
+            /** Non-zero while the receiver (may) sleep on seq. */
+            oro_atomic_t waiters;
+        };
+
+        /**
+         * Precedes the marshalled sample in each slot.
+         */
+        struct ShmSlotHeader
+        {
+            unsigned int size;
+            unsigned int reserved;
+        };
+
+        /**
+         * Forwards the samples of a receiving stream to its channel.
+         * Each receiving stream has one, since a thread can only wait
+         * on a single futex.
+         */
+        class ShmReader : public Activity
+        {
+            ShmSendRecv* shm;
+            base::ChannelElementBase* chan;
+            bool volatile do_exit;
+        public:
+            ShmReader(ShmSendRecv* shm, base::ChannelElementBase* chan, const std::string& name)
+                : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
+                  shm(shm), chan(chan), do_exit(false)
+            {}
+
+            ~ShmReader() {
+                stop();
+            }
+
+            void loop() {
+                while ( !do_exit ) {
+                    if ( shm->shmPending() )
+                        chan->signal();
+                    else
+                        shm->shmWait( Seconds_to_nsecs(0.5) );
+                }
+            }
+
+            bool breakLoop() {
+                do_exit = true;
+                shm->shmWake();
+                return true;
+            }
+        };
+    }
+}
+
+namespace
+{
+    int roundUp(int size, int multiple)
+    {
+        return ((size + multiple - 1) / multiple) * multiple;
+    }
+
+    int futexWait(oro_atomic_t* word, int value, nsecs timeout)
+    {
+        struct timespec ts;
+        ts.tv_sec = timeout / (1000*1000*1000);
+        ts.tv_nsec = timeout % (1000*1000*1000);
+        return syscall(SYS_futex, (int*) word, FUTEX_WAIT, value, &ts, 0, 0);
+    }
+
+    int futexWake(oro_atomic_t* word)
+    {
+        return syscall(SYS_futex, (int*) word, FUTEX_WAKE, 1, 0, 0, 0);
+    }
+
+    ShmSlotHeader* slotAt(ShmRingHeader* ring, unsigned int index)
+    {
+        return (ShmSlotHeader*) ((char*) ring + ring->data_offset + (index % ring->slots) * ring->stride);
+    }
+}
+
+ShmSendRecv::ShmSendRecv(types::TypeMarshaller const& transport) :
+    mtransport(transport), marshaller_cookie(0), shmfd(-1), ring(0), map_size(0), mis_sender(false), minit_done(false), max_size(0), reader(0)
+{
+}
+
+void ShmSendRecv::setupStream(base::DataSourceBase::shared_ptr ds, base::PortInterface* port, ConnPolicy const& policy,
+                              bool is_sender)
+{
+    Logger::In in("ShmSendRecv");
+
+    max_size = policy.data_size ? policy.data_size : mtransport.getSampleSize(ds);
+    marshaller_cookie = mtransport.createCookie();
+    mis_sender = is_sender;
+
+    std::stringstream namestr;
+    namestr << '/' << port->getInterface()->getOwner()->getName() << '.' << port->getName() << '.' << this << '@' << getpid();
+
+    if (policy.name_id.empty())
+        policy.name_id = namestr.str();
+
+    if (policy.name_id[0] != '/' || policy.name_id.find('/', 1) != std::string::npos)
+        throw std::runtime_error("Could not open shared memory object with wrong name. Names must start with '/' and contain no more '/' after the first one.");
+    if (max_size <= 0)
+        throw std::runtime_error("Could not open shared memory object with zero sample size.");
+
+    bool creator = true;
+    shmfd = shm_open(policy.name_id.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IREAD | S_IWRITE);
+    if (shmfd < 0 && errno == EEXIST) {
+        creator = false;
+        shmfd = shm_open(policy.name_id.c_str(), O_RDWR, S_IREAD | S_IWRITE);
+    }
+    if (shmfd < 0) {
+        log(Error) << "FAILED opening '" << policy.name_id << "' for " << (is_sender ? "writing: " : "reading: ") << strerror(errno) << endlog();
+        throw std::runtime_error("Could not open shared memory object: shm_open returned -1.");
+    }
+
+    if (creator) {
+        ShmRingHeader header;
+        header.slots = policy.size ? policy.size : 10;
+        header.slot_size = max_size;
+        header.stride = roundUp(sizeof(ShmSlotHeader) + max_size, ORO_CACHE_LINE_SIZE);
+        header.data_offset = roundUp(sizeof(ShmRingHeader), ORO_CACHE_LINE_SIZE);
+        map_size = header.data_offset + header.slots * header.stride;
+        if ( ftruncate(shmfd, map_size) == -1 ) {
+            log(Error) << "FAILED sizing '" << policy.name_id << "' to " << map_size << " bytes: " << strerror(errno) << endlog();
+            close(shmfd);
+            shm_unlink(policy.name_id.c_str());
+            throw std::runtime_error("Could not size shared memory object: ftruncate returned -1.");
+        }
+        ring = (ShmRingHeader*) mmap(0, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+        if (ring != MAP_FAILED) {
+            ring->slots = header.slots;
+            ring->slot_size = header.slot_size;
+            ring->stride = header.stride;
+            ring->data_offset = header.data_offset;
+            ring->head = 0;
+            ring->tail = 0;
+            oro_atomic_set(&ring->seq, 0);
+            oro_atomic_set(&ring->waiters, 0);
+            oro_wmb();
+            ring->magic = ORO_SHM_MAGIC;
+        }
+    } else {
+        // the creator may still be setting up the object.
+        struct stat st;
+        int tries = 500;
+        while ( fstat(shmfd, &st) == 0 && st.st_size < (off_t) sizeof(ShmRingHeader) && --tries )
+            usleep(1000);
+        map_size = st.st_size;
+        ring = map_size < sizeof(ShmRingHeader) ? (ShmRingHeader*) MAP_FAILED :
+            (ShmRingHeader*) mmap(0, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+        while (ring != MAP_FAILED && ring->magic != ORO_SHM_MAGIC && --tries > 0)
+            usleep(1000);
+        if (ring != MAP_FAILED && ring->magic != ORO_SHM_MAGIC) {
+            munmap(ring, map_size);
+            ring = (ShmRingHeader*) MAP_FAILED;
+        }
+    }
+    if (ring == MAP_FAILED) {
+        ring = 0;
+        log(Error) << "FAILED mapping '" << policy.name_id << "' of " << map_size << " bytes for " << (is_sender ? "writing." : "reading.") << endlog();
+        close(shmfd);
+        shmfd = -1;
+        if (creator)
+            shm_unlink(policy.name_id.c_str());
+        throw std::runtime_error("Could not map shared memory object.");
+    }
+    if (is_sender && ring->slot_size < (unsigned int) max_size) {
+        log(Error) << "'" << policy.name_id << "' has slots of " << ring->slot_size << " bytes, but samples of " << max_size << " bytes are sent." << endlog();
+        munmap(ring, map_size);
+        ring = 0;
+        close(shmfd);
+        shmfd = -1;
+        throw std::runtime_error("Could not use shared memory object with too small slots.");
+    }
+
+    log(Debug) << (creator ? "Created '" : "Opened '") << policy.name_id << "' with shmfd='" << shmfd << "', slot size='" << ring->slot_size << "' and ring length='" << ring->slots << "' for " << (is_sender ? "writing." : "reading.") << endlog();
+
+    shmname = policy.name_id;
+}
+
+ShmSendRecv::~ShmSendRecv()
+{
+    delete reader;
+    if (ring)
+        munmap(ring, map_size);
+    if (shmfd >= 0)
+        close(shmfd);
+}
+
+void ShmSendRecv::cleanupStream()
+{
+    if (!mis_sender)
+    {
+        if (reader)
+        {
+            reader->stop();
+            delete reader;
+            reader = 0;
+        }
+        minit_done = false;
+    }
+    // both sender and receiver unlink, such that a new stream with the
+    // same name does not pick up this ring. The mappings remain valid.
+    shm_unlink(shmname.c_str());
+    // both sender and receiver unmap their end.
+    if (ring)
+    {
+        munmap(ring, map_size);
+        ring = 0;
+    }
+    if (shmfd >= 0)
+    {
+        close(shmfd);
+        shmfd = -1;
+    }
+
+    if (marshaller_cookie)
+    {
+        mtransport.deleteCookie(marshaller_cookie);
+        marshaller_cookie = 0;
+    }
+}
+
+bool ShmSendRecv::shmReady(base::DataSourceBase::shared_ptr ds, base::ChannelElementBase* chan)
+{
+    if (minit_done)
+        return true;
+
+    if (!mis_sender)
+    {
+        // Try to get the initial sample
+        //
+        // The output port implementation guarantees that there will be one
+        // after the connection is ready
+        nsecs deadline = os::TimeService::Instance()->getNSecs() + Seconds_to_nsecs(0.5);
+        nsecs left = deadline - os::TimeService::Instance()->getNSecs();
+        while ( !shmPending() && left > 0 ) {
+            shmWait(left);
+            left = deadline - os::TimeService::Instance()->getNSecs();
+        }
+        if ( !shmPending() )
+        {
+            log(Error) << "Failed to receive initial data sample for shared memory Channel Element." << endlog();
+            return false;
+        }
+        if ( shmRead(ds) )
+        {
+            minit_done = true;
+            // ok, now we can start forwarding.
+            reader = new ShmReader(this, chan, "ShmReader");
+            reader->start();
+            return true;
+        }
+        log(Error) << "Failed to initialize shared memory Channel Element with initial data sample." << endlog();
+        return false;
+    }
+    return false;
+}
+
+bool ShmSendRecv::shmPending() const
+{
+    return ring && ring->head != ring->tail;
+}
+
+void ShmSendRecv::shmWait(nsecs timeout)
+{
+    int seq = oro_atomic_read(&ring->seq);
+    // announce we're going to sleep before checking the ring a last time,
+    // such that the sender either sees us waiting or we see its sample.
+    oro_atomic_inc(&ring->waiters);
+    if ( !shmPending() )
+        futexWait(&ring->seq, seq, timeout);
+    oro_atomic_dec(&ring->waiters);
+}
+
+void ShmSendRecv::shmWake()
+{
+    oro_atomic_inc(&ring->seq);
+    futexWake(&ring->seq);
+}
+
+bool ShmSendRecv::shmRead(RTT::base::DataSourceBase::shared_ptr ds)
+{
+    unsigned int tail = ring->tail;
+    if (ring->head == tail)
+        return false;
+    oro_rmb();
+    ShmSlotHeader* slot = slotAt(ring, tail);
+    bool result = mtransport.updateFromBlob((void*) (slot + 1), slot->size, ds, marshaller_cookie);
+    // the slot is read before it is released.
+    oro_mb();
+    // release the slot to the sender.
+    ring->tail = tail + 1;
+    return result;
+}
+
+bool ShmSendRecv::shmWrite(RTT::base::DataSourceBase::shared_ptr ds)
+{
+    unsigned int head = ring->head;
+    if (head - ring->tail >= ring->slots)
+        return true; // full: drop the sample, as a non-blocking mq_send would.
+    // the receiver released the slot before we overwrite it.
+    oro_mb();
+
+    ShmSlotHeader* slot = slotAt(ring, head);
+    std::pair<void const*, int> blob = mtransport.fillBlob(ds, (void*) (slot + 1), ring->slot_size, marshaller_cookie);
+    if (blob.first == 0 || blob.second > (int) ring->slot_size)
+    {
+        log(Error) << "ShmChannel: failed to marshal sample in slot of " << ring->slot_size << " bytes" << endlog();
+        return false;
+    }
+    if (blob.first != (void const*) (slot + 1))
+        memcpy((void*) (slot + 1), blob.first, blob.second);
+    slot->size = blob.second;
+    oro_wmb();
+    // publish the slot and only wake up the receiver if it sleeps.
+    ring->head = head + 1;
+    oro_atomic_inc(&ring->seq);
+    if ( oro_atomic_read(&ring->waiters) )
+        futexWake(&ring->seq);
+    return true;
+}
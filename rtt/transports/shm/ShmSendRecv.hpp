@@ -0,0 +1,177 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ShmSendRecv.hpp
+
+                        ShmSendRecv.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_SHMSENDRECV_HPP_
+#define ORO_SHMSENDRECV_HPP_
+
+#include "../../rtt-fwd.hpp"
+#include "../../base/DataSourceBase.hpp"
+#include "../../os/Time.hpp"
+#include <string>
+
+namespace RTT
+{
+    namespace shm
+    {
+        struct ShmRingHeader;
+        class ShmReader;
+
+        /**
+         * Implements the sending/receiving of samples through a ring buffer
+         * in a POSIX shared memory object. It can only be OR sender OR
+         * receiver (logical XOR).
+         *
+         * Each stream has its own shared memory object, which holds a
+         * single-producer/single-consumer ring of fixed size slots. The
+         * sender marshals a sample with TypeMarshaller::fillBlob directly
+         * into a free slot, the receiver unmarshals it with
+         * TypeMarshaller::updateFromBlob from that slot, so a sample is
+         * copied once on each side and no system call is done as long as
+         * the receiver is not sleeping. The receiving side is woken up
+         * through a futex in the shared memory object.
+         */
+        class ShmSendRecv
+        {
+        protected:
+            /**
+             * Transport marshaller used for size calculations
+             * and data updates.
+             */
+            types::TypeMarshaller const& mtransport;
+            /**
+             * A private blob that is returned by mtransport.getCookie(). It is
+             * used by the marshallers if they need private internal data to do
+             * the marshalling
+             */
+            void* marshaller_cookie;
+            /**
+             * Shared memory file descriptor.
+             */
+            int shmfd;
+            /**
+             * The mapped shared memory object.
+             */
+            ShmRingHeader* ring;
+            /**
+             * The size of the mapping of ring.
+             */
+            size_t map_size;
+            /**
+             * True if this object is a sender.
+             */
+            bool mis_sender;
+            /**
+             * True if shmReady() received the initial sample, false after cleanupStream().
+             */
+            bool minit_done;
+            /**
+             * The maximum size of a marshalled sample, as specified in the
+             * ConnPolicy when creating the stream, or calculated using the
+             * transport when that size was zero.
+             */
+            int max_size;
+            /**
+             * The name of the shared memory object, as specified in the ConnPolicy when
+             * creating the stream, or self-calculated when that name was empty.
+             */
+            std::string shmname;
+            /**
+             * The thread which waits for new samples on the receiving side.
+             */
+            ShmReader* reader;
+
+        public:
+            /**
+             * Create a channel element for remote data exchange.
+             * @param transport The type specific object that will be used to marshal the data.
+             */
+            ShmSendRecv(types::TypeMarshaller const& transport);
+
+            /**
+             * Creates or opens the shared memory object of this stream.
+             * The side which creates it determines the number of slots
+             * (policy.size, or 10 if zero) and the size of each slot.
+             * @throw std::runtime_error if the object could not be set up.
+             */
+            void setupStream(base::DataSourceBase::shared_ptr ds, base::PortInterface* port, ConnPolicy const& policy, bool is_sender);
+
+            ~ShmSendRecv();
+
+            void cleanupStream();
+
+            /**
+             * Works only in receive mode, waits for the initial sample
+             * and starts the thread that forwards the following ones to \a chan.
+             */
+            virtual bool shmReady(base::DataSourceBase::shared_ptr ds, base::ChannelElementBase* chan);
+
+            /**
+             * Read from the ring buffer.
+             * @param ds stores the resulting data sample.
+             * @return true if an item could be read.
+             */
+            bool shmRead(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Write to the ring buffer. If the ring is full, the
+             * sample is dropped.
+             * @param ds the data sample to write
+             * @return false if the sample could not be marshalled.
+             */
+            bool shmWrite(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Returns true if the ring holds a sample which was not read yet.
+             */
+            bool shmPending() const;
+
+            /**
+             * Waits until the ring holds a sample, until shmWake() is called
+             * or until \a timeout has passed.
+             */
+            void shmWait(nsecs timeout);
+
+            /**
+             * Wakes up a shmWait() on the receiving side.
+             */
+            void shmWake();
+        };
+    }
+}
+
+#endif /* ORO_SHMSENDRECV_HPP_ */
@@ -0,0 +1,82 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ShmTemplateProtocolBase.hpp
+
+                        ShmTemplateProtocolBase.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_SHM_TEMPLATE_PROTOCOL_BASE_HPP
+#define ORO_SHM_TEMPLATE_PROTOCOL_BASE_HPP
+
+#include "ShmLib.hpp"
+#include "../../types/TypeMarshaller.hpp"
+#include "ShmChannelElement.hpp"
+
+namespace RTT
+{ namespace shm
+  {
+      /**
+       * Creates the shared memory streams for type T. Subclasses
+       * implement the TypeMarshaller functions for T.
+       */
+      template<class T>
+      class ShmTemplateProtocolBase
+          : public RTT::types::TypeMarshaller
+      {
+      public:
+          /**
+           * The given \a T parameter is the type for reading DataSources.
+           */
+          typedef T UserType;
+
+          virtual base::ChannelElementBase::shared_ptr createStream(base::PortInterface* port, const ConnPolicy& policy, bool is_sender) const {
+              try {
+                  base::ChannelElementBase::shared_ptr shm = new ShmChannelElement<T>(port, *this, policy, is_sender);
+                  if ( !is_sender ) {
+                      // the receiver needs a buffer to store his messages in.
+                      base::ChannelElementBase::shared_ptr buf = detail::DataSourceTypeInfo<T>::getTypeInfo()->buildDataStorage(policy);
+                      shm->setOutput(buf);
+                  }
+                  return shm;
+              } catch(std::exception& e) {
+                  log(Error) << "Failed to create shared memory Channel element: " << e.what() << endlog();
+              }
+              return base::ChannelElementBase::shared_ptr();
+          }
+
+      };
+}
+}
+
+#endif
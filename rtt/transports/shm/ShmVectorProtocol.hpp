@@ -0,0 +1,96 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  ShmVectorProtocol.hpp
+
+                        ShmVectorProtocol.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_SHM_VECTOR_PROTOCOL_HPP
+#define ORO_SHM_VECTOR_PROTOCOL_HPP
+
+#include "ShmTemplateProtocolBase.hpp"
+#include <vector>
+#include <cstring>
+
+namespace RTT
+{ namespace shm
+  {
+      /**
+       * Transports a std::vector<T> of trivial types T by copying
+       * its elements. The number of elements follows from the size of
+       * the blob. A receiving vector is resized, which only allocates
+       * if its capacity is too small.
+       */
+      template<class T>
+      class ShmVectorProtocol
+          : public ShmTemplateProtocolBase< std::vector<T> >
+      {
+      public:
+          typedef std::vector<T> UserType;
+
+          virtual std::pair<void const*,int> fillBlob( base::DataSourceBase::shared_ptr source, void* blob, int size, void* cookie) const
+          {
+              UserType const* vec = static_cast<UserType const*>( source->getRawConstPointer() );
+              if ( vec && vec->size() * sizeof(T) <= (unsigned int)size ) {
+                  if ( vec->empty() )
+                      return std::make_pair((void const*)blob, int(0));
+                  return std::make_pair((void const*)&(*vec)[0], int(vec->size() * sizeof(T)));
+              }
+              return std::make_pair((void const*)0,int(0));
+          }
+
+          virtual bool updateFromBlob(const void* blob, int size, base::DataSourceBase::shared_ptr target, void* cookie) const
+          {
+              typename internal::AssignableDataSource<UserType>::shared_ptr ad = internal::AssignableDataSource<UserType>::narrow( target.get() );
+              if ( ad ) {
+                  UserType& vec = ad->set();
+                  vec.resize( size / sizeof(T) );
+                  if ( size )
+                      memcpy( &vec[0], blob, size );
+                  return true;
+              }
+              return false;
+          }
+
+          virtual unsigned int getSampleSize(base::DataSourceBase::shared_ptr sample, void* cookie) const
+          {
+              // the sample of an output port does not expose a raw pointer.
+              typename internal::DataSource<UserType>::shared_ptr ds = internal::DataSource<UserType>::narrow( sample.get() );
+              return ds ? ds->get().size() * sizeof(T) : 0;
+          }
+      };
+}
+}
+
+#endif
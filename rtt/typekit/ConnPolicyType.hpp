@@ -59,6 +59,9 @@ namespace boost {
             a & boost::serialization::make_nvp("transport", c.transport );
             a & boost::serialization::make_nvp("data_size", c.data_size );
             a & boost::serialization::make_nvp("name_id", c.name_id );
+            a & boost::serialization::make_nvp("shared", c.shared );
+            a & boost::serialization::make_nvp("readers", c.readers );
+            a & boost::serialization::make_nvp("batch_size", c.batch_size );
         }
     }
 }
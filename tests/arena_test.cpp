@@ -0,0 +1,109 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  arena_test.cpp
+
+                        arena_test.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "unit.hpp"
+
+#include <os/MemoryArena.hpp>
+#include <os/oro_allocator.hpp>
+#include <base/RunnableInterface.hpp>
+#include <Activity.hpp>
+#include <rt_string.hpp>
+
+using namespace std;
+using namespace RTT;
+
+/**
+ * Allocates and releases a block with the rt_allocator,
+ * in the thread of an Activity.
+ */
+struct ArenaUser : public base::RunnableInterface
+{
+    os::rt_allocator<double> alloc;
+    double* block;
+    bool release;
+    os::MemoryArena* arena;
+    ArenaUser() : block(0), release(false), arena(0) {}
+    bool initialize() { return true; }
+    void step() {
+        arena = os::MemoryArena::Current();
+        if (release && block) {
+            alloc.deallocate(block, 16);
+            block = 0;
+        } else if (!release && !block)
+            block = alloc.allocate(16);
+    }
+    void finalize() {}
+};
+
+BOOST_AUTO_TEST_SUITE( MemoryArenaTestSuite )
+
+BOOST_AUTO_TEST_CASE( testCurrentThreadArena )
+{
+    os::MemoryArena arena(64 * 1024);
+    BOOST_CHECK( os::MemoryArena::Current() == 0 );
+    os::MemoryArena::SetCurrent( &arena );
+    {
+        rt_string s("a string which does not fit in a small string buffer");
+        BOOST_CHECK_EQUAL( arena.getBlocks(), 1 );
+        s += s;
+        BOOST_CHECK_EQUAL( arena.getBlocks(), 1 );
+        BOOST_CHECK( arena.getUsedSize() <= arena.getMaxUsedSize() );
+    }
+    BOOST_CHECK_EQUAL( arena.getBlocks(), 0 );
+    os::MemoryArena::SetCurrent( 0 );
+
+    // blocks of the global pool are not counted.
+    rt_string g("a string which does not fit in a small string buffer");
+    BOOST_CHECK_EQUAL( arena.getBlocks(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( testRemoteFree )
+{
+    os::MemoryArena arena(64 * 1024);
+    ArenaUser user;
+    Activity act(0, 0.0, &user, "ArenaUser");
+    act.setMemoryArena( &arena );
+    BOOST_REQUIRE( act.start() );
+
+    // allocate in the thread of the arena.
+    BOOST_REQUIRE( act.trigger() );
+    usleep(100000);
+    BOOST_CHECK( user.arena == &arena );
+    BOOST_REQUIRE( user.block );
+    BOOST_CHECK_EQUAL( arena.getBlocks(), 1 );
+
+    // release in this thread: queued until the owner allocates again.
+    user.alloc.deallocate(user.block, 16);
+    user.block = 0;
+    BOOST_CHECK_EQUAL( arena.getRemoteFrees(), 1 );
+    BOOST_CHECK_EQUAL( arena.getBlocks(), 1 );
+
+    BOOST_REQUIRE( act.trigger() );
+    usleep(100000);
+    BOOST_REQUIRE( user.block );
+    BOOST_CHECK_EQUAL( arena.getBlocks(), 1 );
+
+    // release in the owner thread.
+    user.release = true;
+    BOOST_REQUIRE( act.trigger() );
+    usleep(100000);
+    BOOST_CHECK( user.block == 0 );
+    BOOST_CHECK_EQUAL( arena.getBlocks(), 0 );
+    BOOST_CHECK( act.stop() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -23,6 +23,7 @@
 
 #include <internal/AtomicQueue.hpp>
 #include <internal/AtomicMWSRQueue.hpp>
+#include <internal/SegmentedMWSRQueue.hpp>
 
 #include <Activity.hpp>
 
@@ -75,6 +76,7 @@ public:
 
 typedef AtomicQueue<Dummy*> QueueType;
 typedef AtomicMWSRQueue<Dummy*> MWSRQueueType;
+typedef SegmentedMWSRQueue<Dummy*> SegmentedQueueType;
 
 // Don't make queue size too large, we want to catch
 // overrun issues too.
@@ -133,6 +135,8 @@ public:
     DataObjectLocked<Dummy>* dlocked;
     DataObjectLockFree<Dummy>* dlockfree;
     DataObjectUnSync<Dummy>* dunsync;
+    DataObjectWaitFree<Dummy>* dwaitfree;
+    DataObjectSeqLock<Dummy>* dseqlock;
 
     ThreadInterface* athread;
     ThreadInterface* bthread;
@@ -156,6 +160,8 @@ public:
         dlockfree = new DataObjectLockFree<Dummy>();
         dlocked   = new DataObjectLocked<Dummy>();
         dunsync   = new DataObjectUnSync<Dummy>();
+        dwaitfree = new DataObjectWaitFree<Dummy>(Dummy(), 3);
+        dseqlock  = new DataObjectSeqLock<Dummy>();
 
         // defaults
         buffer = lockfree;
@@ -172,6 +178,8 @@ public:
         delete dlockfree;
         delete dlocked;
         delete dunsync;
+        delete dwaitfree;
+        delete dseqlock;
     }
 };
 
@@ -570,6 +578,47 @@ struct LLFGrower : public RunnableInterface
     }
 };
 
+/**
+ * Sets or gets a data object and checks that
+ * each sample read is consistent and not older than the previous one.
+ */
+struct DObjWorker : public RunnableInterface
+{
+    volatile bool stop;
+    DataObjectInterface<Dummy>* mdobj;
+    bool writer;
+    int reads;
+    int errors;
+    DObjWorker(DataObjectInterface<Dummy>* d, bool writer ) : stop(false), mdobj(d), writer(writer), reads(0), errors(0) {}
+    bool initialize() {
+        stop = false; reads = 0; errors = 0;
+        return true;
+    }
+    void step() {
+        double i = 0;
+        Dummy d;
+        while (stop == false ) {
+            if (writer) {
+                ++i;
+                mdobj->Set( Dummy(i,i,i) );
+            } else {
+                mdobj->Get( d );
+                if ( d.d1 != d.d2 || d.d1 != d.d3 || d.d1 < i )
+                    ++errors;
+                i = d.d1;
+                ++reads;
+            }
+        }
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
 /**
  * A Worker Reads and writes the queue.
  */
@@ -783,6 +832,63 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
     delete d;
 }
 
+BOOST_AUTO_TEST_CASE( testSegmentedMWSRQueue )
+{
+    /**
+     * Single Threaded test for SegmentedMWSRQueue.
+     */
+    Dummy d[5 * QS];
+    Dummy* c = 0;
+
+    // without pool, the queue has a fixed size.
+    SegmentedQueueType fixed(QS);
+    BOOST_CHECK( fixed.isGrowable() == false );
+    for ( int i = 0; i < QS; ++i)
+        BOOST_CHECK( fixed.enqueue( &d[i] ) == true);
+    BOOST_CHECK( fixed.isFull() == true );
+    BOOST_CHECK( fixed.enqueue( &d[QS] ) == false );
+    BOOST_REQUIRE_EQUAL( SegmentedQueueType::size_type(QS), fixed.size() );
+
+    // with a pool of two segments, it holds three times as much.
+    boost::shared_ptr<SegmentedQueueType::SegmentPool> pool( new SegmentedQueueType::SegmentPool(2, QS) );
+    SegmentedQueueType growable(QS, pool);
+    BOOST_CHECK( growable.isGrowable() == true );
+    BOOST_REQUIRE_EQUAL( SegmentedQueueType::size_type(QS), growable.capacity() );
+    BOOST_CHECK( growable.isEmpty() == true );
+    BOOST_CHECK( growable.dequeue(c) == false );
+
+    for ( int i = 0; i < 3 * QS; ++i) {
+        BOOST_CHECK( growable.enqueue( &d[i] ) == true);
+        BOOST_REQUIRE_EQUAL( SegmentedQueueType::size_type(i+1), growable.size() );
+    }
+    BOOST_CHECK( growable.isFull() == false );
+    // pool exhausted.
+    BOOST_CHECK( growable.enqueue( &d[3 * QS] ) == false );
+
+    // elements come out in order and segments return to the pool.
+    for ( int i = 0; i < 3 * QS; ++i) {
+        BOOST_CHECK( growable.dequeue( c ) == true);
+        BOOST_CHECK_EQUAL( c, &d[i] );
+    }
+    BOOST_CHECK( growable.isEmpty() == true );
+    BOOST_CHECK( growable.dequeue(c) == false );
+    BOOST_REQUIRE_EQUAL( SegmentedQueueType::size_type(0), growable.size() );
+
+    // the pool is shared with other queues, which return
+    // their segments when they are destroyed.
+    {
+        SegmentedQueueType other(QS, pool);
+        for ( int i = 0; i < 2 * QS; ++i)
+            BOOST_CHECK( other.enqueue( &d[i] ) == true);
+        for ( int i = 0; i < 2 * QS; ++i)
+            BOOST_CHECK( growable.enqueue( &d[i] ) == true);
+        BOOST_CHECK( growable.enqueue( &d[2 * QS] ) == false );
+    }
+    BOOST_CHECK( growable.enqueue( &d[2 * QS] ) == true );
+    growable.clear();
+    BOOST_CHECK( growable.isEmpty() == true );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE( BuffersDataFlowTestSuite, BuffersDataFlowTest )
@@ -829,6 +935,18 @@ BOOST_AUTO_TEST_CASE( testDObjUnSync )
     testDObj();
 }
 
+BOOST_AUTO_TEST_CASE( testDObjWaitFree )
+{
+    dataobj = dwaitfree;
+    testDObj();
+}
+
+BOOST_AUTO_TEST_CASE( testDObjSeqLock )
+{
+    dataobj = dseqlock;
+    testDObj();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_FIXTURE_TEST_SUITE( BuffersMPoolTestSuite, BuffersMPoolTest )
 
@@ -1083,6 +1201,63 @@ BOOST_AUTO_TEST_CASE( testAtomicQueue )
     delete eater;
 }
 
+BOOST_AUTO_TEST_CASE( testDataObjectWaitFree )
+{
+    DataObjectWaitFree<Dummy> dobj(Dummy(0,0,0), 3);
+    DObjWorker writer( &dobj, true );
+    DObjWorker aworker( &dobj, false );
+    DObjWorker bworker( &dobj, false );
+    DObjWorker cworker( &dobj, false );
+
+    {
+        boost::scoped_ptr<Activity> wthread( new Activity(ORO_SCHED_OTHER, 0, 0, &writer, "ActivityW" ));
+        boost::scoped_ptr<Activity> athread( new Activity(ORO_SCHED_OTHER, 0, 0, &aworker, "ActivityA" ));
+        boost::scoped_ptr<Activity> bthread( new Activity(ORO_SCHED_OTHER, 0, 0, &bworker, "ActivityB" ));
+        boost::scoped_ptr<Activity> cthread( new Activity(ORO_SCHED_OTHER, 0, 0, &cworker, "ActivityC" ));
+
+        wthread->start();
+        athread->start();
+        bthread->start();
+        cthread->start();
+        sleep(3);
+        athread->stop();
+        bthread->stop();
+        cthread->stop();
+        wthread->stop();
+    }
+
+    BOOST_CHECK( aworker.reads > 0 );
+    BOOST_CHECK_EQUAL( aworker.errors, 0 );
+    BOOST_CHECK_EQUAL( bworker.errors, 0 );
+    BOOST_CHECK_EQUAL( cworker.errors, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( testDataObjectSeqLock )
+{
+    DataObjectSeqLock<Dummy> dobj(Dummy(0,0,0));
+    DObjWorker writer( &dobj, true );
+    DObjWorker aworker( &dobj, false );
+    DObjWorker bworker( &dobj, false );
+
+    {
+        boost::scoped_ptr<Activity> wthread( new Activity(ORO_SCHED_OTHER, 0, 0, &writer, "ActivityW" ));
+        boost::scoped_ptr<Activity> athread( new Activity(ORO_SCHED_OTHER, 0, 0, &aworker, "ActivityA" ));
+        boost::scoped_ptr<Activity> bthread( new Activity(ORO_SCHED_OTHER, 0, 0, &bworker, "ActivityB" ));
+
+        wthread->start();
+        athread->start();
+        bthread->start();
+        sleep(3);
+        athread->stop();
+        bthread->stop();
+        wthread->stop();
+    }
+
+    BOOST_CHECK( aworker.reads > 0 );
+    BOOST_CHECK_EQUAL( aworker.errors, 0 );
+    BOOST_CHECK_EQUAL( bworker.errors, 0 );
+}
+
 BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
 {
     MWSRQueueType* qt = new MWSRQueueType(QS);
@@ -1155,5 +1330,67 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
     delete grower;
     delete eater;
 }
+
+BOOST_AUTO_TEST_CASE( testSegmentedMWSRQueue )
+{
+    boost::shared_ptr<SegmentedQueueType::SegmentPool> pool( new SegmentedQueueType::SegmentPool(4, QS) );
+    SegmentedQueueType* qt = new SegmentedQueueType(QS, pool);
+    AQGrower<SegmentedQueueType>* aworker = new AQGrower<SegmentedQueueType>( qt );
+    AQGrower<SegmentedQueueType>* bworker = new AQGrower<SegmentedQueueType>( qt );
+    AQGrower<SegmentedQueueType>* grower = new AQGrower<SegmentedQueueType>( qt );
+    AQEater<SegmentedQueueType>* eater = new AQEater<SegmentedQueueType>( qt );
+
+    {
+        boost::scoped_ptr<Activity> athread( new Activity(20, aworker, "ActivityA" ));
+        boost::scoped_ptr<Activity> bthread( new Activity(20, bworker, "ActivityB" ));
+        boost::scoped_ptr<Activity> gthread( new Activity(20, grower, "ActivityG"));
+        boost::scoped_ptr<Activity> ethread( new Activity(20, eater, "ActivityE"));
+
+        // avoid system lock-ups
+        athread->thread()->setScheduler(ORO_SCHED_OTHER);
+        bthread->thread()->setScheduler(ORO_SCHED_OTHER);
+        gthread->thread()->setScheduler(ORO_SCHED_OTHER);
+        ethread->thread()->setScheduler(ORO_SCHED_OTHER);
+
+        log(Info) <<"Stressing growing multi-write/single-read..." <<endlog();
+        athread->start();
+        bthread->start();
+        gthread->start();
+        ethread->start();
+        sleep(5);
+        athread->stop();
+        bthread->stop();
+        gthread->stop();
+        ethread->stop();
+    }
+
+    int i = 0; // left-over count
+    Dummy* d = 0;
+    BOOST_CHECK( qt->size() <= 5 * QS );
+    while( qt->dequeue(d) ) {
+        BOOST_CHECK( d );
+        i++;
+        if ( i > 5 * QS ) {
+            BOOST_CHECK( i <= 5 * QS); // avoid infinite loop.
+            break;
+        }
+    }
+    cout << "Left in Queue: "<< i <<endl;
+    BOOST_CHECK( qt->isEmpty() );
+
+    // assert: sum queues == sum dequeues
+    BOOST_CHECK_EQUAL( aworker->appends + bworker->appends + grower->appends,
+                       i + eater->erases );
+
+    // all segments are back in the pool.
+    delete qt;
+    SegmentedQueueType check(QS, pool);
+    for ( int j = 0; j < 5 * QS; ++j)
+        BOOST_CHECK( check.enqueue( aworker->orig ) == true );
+    delete aworker;
+    delete bworker;
+    delete grower;
+    delete eater;
+}
 #endif
 BOOST_AUTO_TEST_SUITE_END()
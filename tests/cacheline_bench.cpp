@@ -0,0 +1,246 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  cacheline_bench.cpp
+
+                        cacheline_bench.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/**
+ * @file cacheline_bench.cpp
+ * Measures the throughput of the lock-free primitives when a producer
+ * and a consumer run on different CPUs. Two counters are measured with
+ * and without padding between them, which shows the cost of false
+ * sharing on this machine. The library primitives are measured with
+ * the ORO_CACHE_LINE_SIZE the library was configured with, which can
+ * only be changed at configure time. To compare them without padding,
+ * configure a second build with OS_CACHE_LINE_SIZE set to 8 and compare
+ * the results of both. The results are printed as CSV on standard output:
+ *
+ * @verbatim
+ * cacheline-bench > results.csv
+ * @endverbatim
+ */
+
+#include <os/main.h>
+#include <internal/AtomicQueue.hpp>
+#include <internal/AtomicMWSRQueue.hpp>
+#include <internal/TsPool.hpp>
+#include <base/DataObjectLockFree.hpp>
+#include <base/DataObjectSeqLock.hpp>
+#include <base/RunnableInterface.hpp>
+#include <os/TimeService.hpp>
+#include <Activity.hpp>
+#include <rtt-config.h>
+
+#include <boost/scoped_ptr.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+
+// The time each benchmark runs.
+#define BENCH_USECS 500000
+
+/**
+ * The throughput of the two threads of one benchmark.
+ */
+struct CacheLineResult
+{
+    std::string name;
+    unsigned int padding;
+    long a_ops;
+    long b_ops;
+};
+
+namespace {
+    using namespace RTT;
+
+    struct Sample {
+        double d[3];
+    };
+
+    /**
+     * Two counters which are written by different threads,
+     * \a Pad bytes apart.
+     */
+    template<unsigned int Pad>
+    struct Counters {
+        volatile long a;
+        char pad[Pad];
+        volatile long b;
+    };
+
+    /**
+     * Two counters without padding, which share a cache line.
+     */
+    template<>
+    struct Counters<0> {
+        volatile long a;
+        volatile long b;
+    };
+
+    /**
+     * Calls \a F until it is stopped and counts
+     * the calls which succeeded.
+     */
+    template<class F>
+    struct BenchWorker : public base::RunnableInterface
+    {
+        volatile bool stop;
+        F f;
+        long ops;
+        BenchWorker(F f) : stop(false), f(f), ops(0) {}
+        bool initialize() {
+            stop = false; ops = 0;
+            return true;
+        }
+        void step() {
+            while (stop == false) {
+                if ( f() )
+                    ++ops;
+            }
+        }
+        void finalize() {}
+        bool breakLoop() {
+            stop = true;
+            return true;
+        }
+    };
+
+    struct Increment {
+        volatile long* counter;
+        Increment(volatile long* c) : counter(c) {}
+        bool operator()() { ++*counter; return true; }
+    };
+
+    template<class Q>
+    struct Enqueue {
+        Q* queue;
+        Sample* sample;
+        Enqueue(Q* q, Sample* s) : queue(q), sample(s) {}
+        bool operator()() { return queue->enqueue(sample); }
+    };
+
+    template<class Q>
+    struct Dequeue {
+        Q* queue;
+        Dequeue(Q* q) : queue(q) {}
+        bool operator()() { Sample* s; return queue->dequeue(s); }
+    };
+
+    struct AllocateDeallocate {
+        internal::TsPool<Sample>* pool;
+        AllocateDeallocate(internal::TsPool<Sample>* p) : pool(p) {}
+        bool operator()() { return pool->deallocate( pool->allocate() ); }
+    };
+
+    template<class D>
+    struct SetSample {
+        D* dobj;
+        Sample sample;
+        SetSample(D* d) : dobj(d), sample() {}
+        bool operator()() { ++sample.d[0]; dobj->Set(sample); return true; }
+    };
+
+    template<class D>
+    struct GetSample {
+        D* dobj;
+        Sample sample;
+        GetSample(D* d) : dobj(d), sample() {}
+        bool operator()() { dobj->Get(sample); return true; }
+    };
+
+    /**
+     * Runs \a a on the first CPU and \a b on the second CPU and
+     * records their throughput.
+     */
+    template<class A, class B>
+    void runBench(std::vector<CacheLineResult>& results, const std::string& name, unsigned int padding, A a, B b)
+    {
+        BenchWorker<A> aworker(a);
+        BenchWorker<B> bworker(b);
+        unsigned acpu = ~0, bcpu = ~0;
+#ifdef _SC_NPROCESSORS_ONLN
+        if ( sysconf(_SC_NPROCESSORS_ONLN) > 1 ) {
+            acpu = 1 << 0;
+            bcpu = 1 << 1;
+        }
+#endif
+        os::TimeService::ticks start = os::TimeService::Instance()->getTicks();
+        {
+            boost::scoped_ptr<Activity> athread( new Activity(ORO_SCHED_OTHER, 0, 0, acpu, &aworker, "BenchA" ));
+            boost::scoped_ptr<Activity> bthread( new Activity(ORO_SCHED_OTHER, 0, 0, bcpu, &bworker, "BenchB" ));
+            athread->start();
+            bthread->start();
+            usleep(BENCH_USECS);
+            athread->stop();
+            bthread->stop();
+        }
+        Seconds elapsed = os::TimeService::Instance()->secondsSince(start);
+
+        CacheLineResult result;
+        result.name = name;
+        result.padding = padding;
+        result.a_ops = long(aworker.ops / elapsed);
+        result.b_ops = long(bworker.ops / elapsed);
+        results.push_back(result);
+    }
+
+    /**
+     * Runs all benchmarks. The counters are measured with and without
+     * padding, the library primitives with the configured ORO_CACHE_LINE_SIZE.
+     */
+    void runCacheLineBenchmarks(std::vector<CacheLineResult>& results)
+    {
+        Counters<0> packed;
+        packed.a = packed.b = 0;
+        runBench(results, "Counters", 0, Increment(&packed.a), Increment(&packed.b));
+
+        Counters<ORO_CACHE_LINE_SIZE> padded;
+        padded.a = padded.b = 0;
+        runBench(results, "Counters", ORO_CACHE_LINE_SIZE, Increment(&padded.a), Increment(&padded.b));
+
+        Sample sample;
+        typedef internal::AtomicQueue<Sample*> Queue;
+        Queue queue(64);
+        runBench(results, "AtomicQueue", ORO_CACHE_LINE_SIZE, Enqueue<Queue>(&queue, &sample), Dequeue<Queue>(&queue));
+
+        typedef internal::AtomicMWSRQueue<Sample*> MWSRQueue;
+        MWSRQueue mwsr(64);
+        runBench(results, "AtomicMWSRQueue", ORO_CACHE_LINE_SIZE, Enqueue<MWSRQueue>(&mwsr, &sample), Dequeue<MWSRQueue>(&mwsr));
+
+        internal::TsPool<Sample> pool(8);
+        runBench(results, "TsPool", ORO_CACHE_LINE_SIZE, AllocateDeallocate(&pool), AllocateDeallocate(&pool));
+
+        typedef base::DataObjectLockFree<Sample> LockFree;
+        LockFree lockfree;
+        runBench(results, "DataObjectLockFree", ORO_CACHE_LINE_SIZE, SetSample<LockFree>(&lockfree), GetSample<LockFree>(&lockfree));
+
+        typedef base::DataObjectSeqLock<Sample> SeqLock;
+        SeqLock seqlock;
+        runBench(results, "DataObjectSeqLock", ORO_CACHE_LINE_SIZE, SetSample<SeqLock>(&seqlock), GetSample<SeqLock>(&seqlock));
+    }
+}
+
+int ORO_main(int argc, char** argv)
+{
+    vector<CacheLineResult> results;
+    runCacheLineBenchmarks(results);
+
+    cout << "benchmark,padding,a_ops_per_s,b_ops_per_s" << endl;
+    for (unsigned int i = 0; i != results.size(); ++i)
+        cout << results[i].name << "," << results[i].padding << "," << results[i].a_ops << "," << results[i].b_ops << endl;
+    return 0;
+}
@@ -25,6 +25,8 @@
 
 #include <rtt-fwd.hpp>
 #include <transports/mqueue/binary_data_archive.hpp>
+#include <transports/mqueue/MQBitwiseProtocol.hpp>
+#include <internal/DataSources.hpp>
 #include <os/fosi.h>
 
 using namespace std;
@@ -33,6 +35,12 @@ using namespace RTT::detail;
 using namespace RTT::mqueue;
 namespace io = boost::iostreams;
 
+struct FlatSample
+{
+    double position[3];
+    int id;
+};
+
 class MQueueArchiveTest
 {
 public:
@@ -146,5 +154,44 @@ BOOST_AUTO_TEST_CASE( testMakeArrayBinaryDataArchive )
     BOOST_CHECK_EQUAL( stored, in.getArchiveSize() );
 }
 
+// Test the raw copy of flat types, which bypasses the archive.
+BOOST_AUTO_TEST_CASE( testBitwiseProtocol )
+{
+    char blob[1000];
+    MQBitwiseProtocol< vector<double> > vproto;
+    ValueDataSource< vector<double> >::shared_ptr vsrc = new ValueDataSource< vector<double> >( vector<double>(10, 3.33) );
+    ValueDataSource< vector<double> >::shared_ptr vdst = new ValueDataSource< vector<double> >( vector<double>(20, 0.0) );
+
+    rtos_enable_rt_warning();
+    std::pair<void const*,int> stored = vproto.fillBlob( vsrc, blob, 1000, 0 );
+    BOOST_CHECK( vproto.updateFromBlob( blob, stored.second, vdst, 0 ) );
+    rtos_disable_rt_warning();
+
+    BOOST_CHECK( stored.first == blob );
+    BOOST_CHECK_EQUAL( stored.second, int(sizeof(MQBitwiseHeader) + 10 * sizeof(double)) );
+    BOOST_CHECK_EQUAL( vproto.getSampleSize( vsrc, 0 ), unsigned(stored.second) );
+    BOOST_CHECK_EQUAL( vdst->rvalue().size(), 10 );
+    BOOST_CHECK_EQUAL( vdst->rvalue().capacity(), 20 );
+    BOOST_CHECK_EQUAL( vdst->rvalue()[9], 3.33 );
+
+    // does not fit:
+    BOOST_CHECK( vproto.fillBlob( vsrc, blob, 10 * sizeof(double), 0 ).first == 0 );
+
+    MQBitwiseProtocol<FlatSample> fproto;
+    FlatSample flat = { {1.0, 2.0, 3.0}, 7 };
+    ValueDataSource<FlatSample>::shared_ptr fsrc = new ValueDataSource<FlatSample>( flat );
+    ValueDataSource<FlatSample>::shared_ptr fdst = new ValueDataSource<FlatSample>();
+
+    stored = fproto.fillBlob( fsrc, blob, 1000, 0 );
+    BOOST_CHECK_EQUAL( stored.second, int(sizeof(MQBitwiseHeader) + sizeof(FlatSample)) );
+    BOOST_CHECK( fproto.updateFromBlob( blob, stored.second, fdst, 0 ) );
+    BOOST_CHECK_EQUAL( fdst->get().position[2], 3.0 );
+    BOOST_CHECK_EQUAL( fdst->get().id, 7 );
+
+    // a message of another type is rejected:
+    BOOST_CHECK( vproto.updateFromBlob( blob, stored.second, vdst, 0 ) == false );
+    BOOST_CHECK_EQUAL( vdst->rvalue().size(), 10 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,135 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  mqueue_bench.cpp
+
+                        mqueue_bench.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/**
+ * @file mqueue_bench.cpp
+ * Compares the cost of marshalling a sample for the mqueue transport
+ * with MQSerializationProtocol, which writes a binary_data_archive, and
+ * with MQBitwiseProtocol, which copies the raw bytes after a small header.
+ *
+ * Each operation marshals a sample into a message buffer and unmarshals
+ * it again, which is what a sender and receiver do per sample. The
+ * percentiles are printed as CSV on standard output:
+ *
+ * @verbatim
+ * mqueue-bench [operations per benchmark] > results.csv
+ * @endverbatim
+ */
+
+#include <os/main.h>
+#include <os/TimeService.hpp>
+#include <transports/mqueue/MQSerializationProtocol.hpp>
+#include <transports/mqueue/MQBitwiseProtocol.hpp>
+#include <internal/DataSources.hpp>
+
+#include <boost/serialization/vector.hpp>
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace RTT;
+using namespace RTT::mqueue;
+
+typedef os::TimeService::nsecs nsecs;
+typedef std::vector<nsecs> Latencies;
+
+/**
+ * A flat struct, as found in sensor and control data.
+ */
+struct FlatSample
+{
+    double position[3];
+    double velocity[3];
+    double orientation[4];
+    int id;
+};
+
+namespace boost { namespace serialization {
+    template<class Archive>
+    void serialize(Archive& a, FlatSample& s, unsigned int)
+    {
+        a & make_nvp("position", make_array(s.position, 3));
+        a & make_nvp("velocity", make_array(s.velocity, 3));
+        a & make_nvp("orientation", make_array(s.orientation, 4));
+        a & make_nvp("id", s.id);
+    }
+}}
+
+static inline nsecs now()
+{
+    return os::TimeService::Instance()->getNSecs();
+}
+
+/**
+ * Marshals and unmarshals \a sample \a count times with \a protocol
+ * and prints the percentiles of the durations.
+ */
+template<class T>
+static void benchProtocol(const string& name, types::TypeMarshaller const& protocol, T const& sample, unsigned int count)
+{
+    typename internal::ValueDataSource<T>::shared_ptr source = new internal::ValueDataSource<T>( sample );
+    typename internal::ValueDataSource<T>::shared_ptr target = new internal::ValueDataSource<T>( sample );
+    void* cookie = protocol.createCookie();
+    vector<char> blob( protocol.getSampleSize( source, cookie ) );
+
+    Latencies latencies;
+    latencies.reserve(count);
+    for (unsigned int i = 0; i != count; ++i) {
+        nsecs start = now();
+        std::pair<void const*,int> stored = protocol.fillBlob( source, &blob[0], blob.size(), cookie );
+        if ( stored.first == 0 || !protocol.updateFromBlob( stored.first, stored.second, target, cookie ) ) {
+            cerr << name << ": marshalling failed." << endl;
+            break;
+        }
+        latencies.push_back( now() - start );
+    }
+    protocol.deleteCookie(cookie);
+    if ( latencies.empty() )
+        return;
+
+    sort( latencies.begin(), latencies.end() );
+    cout << name << "," << blob.size() << "," << latencies.size() << ","
+         << latencies[ latencies.size() * 50 / 100 ] << ","
+         << latencies[ latencies.size() * 99 / 100 ] << ","
+         << latencies[ latencies.size() * 999 / 1000 ] << ","
+         << latencies.back() << endl;
+}
+
+template<class T>
+static void benchSample(const string& name, T const& sample, unsigned int count)
+{
+    benchProtocol<T>("MQSerializationProtocol<" + name + ">", MQSerializationProtocol<T>(), sample, count);
+    benchProtocol<T>("MQBitwiseProtocol<" + name + ">", MQBitwiseProtocol<T>(), sample, count);
+}
+
+int ORO_main(int argc, char** argv)
+{
+    unsigned int count = 100000;
+    if ( argc > 1 )
+        count = atoi( argv[1] );
+
+    cout << "benchmark,message_bytes,operations,p50_ns,p99_ns,p99.9_ns,max_ns" << endl;
+    FlatSample flat = { {1, 2, 3}, {4, 5, 6}, {0, 0, 0, 1}, 42 };
+    benchSample("FlatSample", flat, count);
+    unsigned int sizes[] = { 16, 512, 8192 };
+    for (unsigned int i = 0; i != sizeof(sizes) / sizeof(sizes[0]); ++i)
+        benchSample("vector<double>", vector<double>(sizes[i], 1.0), count);
+    return 0;
+}
@@ -24,6 +24,9 @@
 #include <transports/mqueue/MQLib.hpp>
 #include <transports/mqueue/MQChannelElement.hpp>
 #include <transports/mqueue/MQTemplateProtocol.hpp>
+#include <transports/mqueue/MQBitwiseProtocol.hpp>
+#include <transports/mqueue/MQSendRecv.hpp>
+#include <internal/DataSources.hpp>
 #include <os/fosi.h>
 
 using namespace std;
@@ -111,6 +114,17 @@ public:
     }
 };
 
+/**
+ * Gives access to the buffer sizes of an MQSendRecv.
+ */
+class MQSizes : public mqueue::MQSendRecv
+{
+public:
+    MQSizes(types::TypeMarshaller const& transport) : MQSendRecv(transport) {}
+    int bufferSize() const { return max_size; }
+    int messageSize() const { return mmsg_size; }
+};
+
 #define ASSERT_PORT_SIGNALLING(code, read_port) \
     signalled_port = 0; \
     code; \
@@ -324,6 +338,51 @@ BOOST_AUTO_TEST_CASE( testPortStreamsWrongName )
     mw2->disconnect();
 }
 
+BOOST_AUTO_TEST_CASE( testBatchedStreams )
+{
+    // The same data and buffer tests, with a batching sender.
+    policy.batch_size = 5;
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/bdata1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.size = 3;
+    policy.name_id = "/bbuffer1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortBufferConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    // A burst of samples must arrive complete and in order.
+    policy.size = 10;
+    policy.name_id = "/bbuffer2";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    rtos_enable_rt_warning();
+    for (int i = 0; i != 10; ++i)
+        mw1->write( double(i) );
+    rtos_disable_rt_warning();
+    usleep(200000);
+    double value = -1;
+    for (int i = 0; i != 10; ++i) {
+        BOOST_CHECK_EQUAL( mr2->read(value), NewData );
+        BOOST_CHECK_EQUAL( value, double(i) );
+    }
+    BOOST_CHECK_EQUAL( mr2->read(value), OldData );
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+}
+
 // copied from testPortStreams
 BOOST_AUTO_TEST_CASE( testVectorTransport )
 {
@@ -381,5 +440,52 @@ BOOST_AUTO_TEST_CASE( testVectorTransport )
     rtos_disable_rt_warning();
 }
 
+BOOST_AUTO_TEST_CASE( testBufferGrowth )
+{
+    // each sample takes an 8 byte header and 8 bytes per element.
+    mqueue::MQBitwiseProtocol< std::vector<double> > proto;
+    internal::ValueDataSource< std::vector<double> >::shared_ptr sample
+        = new internal::ValueDataSource< std::vector<double> >( std::vector<double>(10, 1.0) );
+    MQSizes mq( proto );
+    policy.type = ConnPolicy::BUFFER;
+    policy.data_size = 4096;
+    policy.name_id = "/growing1";
+    mq.setupStream( sample, mw1, policy, true );
+
+    // the queue takes the largest sample, the buffer the current one.
+    BOOST_CHECK_EQUAL( mq.messageSize(), 4096 );
+    BOOST_CHECK_EQUAL( mq.bufferSize(), 88 );
+
+    // growth on write, by at least half.
+    sample->set().resize(100);
+    BOOST_CHECK( mq.mqWrite( sample ) );
+    BOOST_CHECK_EQUAL( mq.bufferSize(), 808 );
+    sample->set().resize(101);
+    BOOST_CHECK( mq.mqWrite( sample ) );
+    BOOST_CHECK_EQUAL( mq.bufferSize(), 808 + 808 / 2 );
+    sample->set().resize(120);
+    BOOST_CHECK( mq.mqWrite( sample ) );
+    BOOST_CHECK_EQUAL( mq.bufferSize(), 808 + 808 / 2 );
+
+    // only shrinks when less than a quarter is used.
+    sample->set().resize(60);
+    mq.mqNewSample( sample );
+    BOOST_CHECK_EQUAL( mq.bufferSize(), 808 + 808 / 2 );
+    sample->set().resize(20);
+    mq.mqNewSample( sample );
+    BOOST_CHECK_EQUAL( mq.bufferSize(), 168 );
+
+    // the buffer grows up to the message size of the queue, but not beyond.
+    sample->set().resize(511);
+    BOOST_CHECK( mq.mqWrite( sample ) );
+    BOOST_CHECK_EQUAL( mq.bufferSize(), 4096 );
+    sample->set().resize(512);
+    BOOST_CHECK( mq.mqWrite( sample ) == false );
+    BOOST_CHECK_EQUAL( mq.bufferSize(), 4096 );
+
+    BOOST_CHECK_EQUAL( mq.mqHighWater(), 4096 );
+    mq.cleanupStream();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -24,6 +24,7 @@
 #include <rtt/Service.hpp>
 #include <rtt/OperationCaller.hpp>
 #include <rtt/TaskContext.hpp>
+#include <rtt/extras/SlaveActivity.hpp>
 
 using namespace std;
 using namespace RTT::detail;
@@ -184,6 +185,41 @@ BOOST_AUTO_TEST_CASE( testOperationCall2 )
     BOOST_CHECK_EQUAL( 1.0, m0.call() );
 }
 
+// Test sending to an operation with a fixed number of pending calls.
+BOOST_AUTO_TEST_CASE( testOperationMaxPendingCalls )
+{
+    // the slave only processes the calls when it is executed.
+    TaskContext tc2("TC2");
+    tc2.setActivity( new extras::SlaveActivity() );
+
+    tc2.provides()->addOperation("op1", &OperationTest::func1, this, OwnThread).setMaxPendingCalls(2);
+    OperationCaller<double(int)> m1( tc2.provides()->getOperation("op1"), tc.engine() );
+    BOOST_REQUIRE( m1.ready() );
+
+    double ret = 0.0;
+    SendHandle<double(int)> h1 = m1.send(1);
+    SendHandle<double(int)> h2 = m1.send(2);
+    SendHandle<double(int)> h3 = m1.send(3);
+    BOOST_CHECK_EQUAL( h1.collectIfDone(ret), SendNotReady );
+    BOOST_CHECK_EQUAL( h2.collectIfDone(ret), SendNotReady );
+    BOOST_CHECK_EQUAL( h3.collectIfDone(ret), SendFailure );
+
+    BOOST_CHECK( tc2.engine()->getActivity()->execute() );
+    BOOST_CHECK_EQUAL( h1.collectIfDone(ret), SendSuccess );
+    BOOST_CHECK_EQUAL( ret, 2.0 );
+    BOOST_CHECK_EQUAL( h2.collectIfDone(ret), SendSuccess );
+
+    // releasing the handles frees the pool again, once tc
+    // has disposed of the returned calls.
+    h1 = SendHandle<double(int)>();
+    h2 = SendHandle<double(int)>();
+    usleep(100000);
+    h3 = m1.send(3);
+    BOOST_CHECK_EQUAL( h3.collectIfDone(ret), SendNotReady );
+    BOOST_CHECK( tc2.engine()->getActivity()->execute() );
+    BOOST_CHECK_EQUAL( h3.collectIfDone(ret), SendSuccess );
+}
+
 // Test adding a C++ function to the services.
 BOOST_AUTO_TEST_CASE( testOperationAddCpp )
 {
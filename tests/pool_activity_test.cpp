@@ -0,0 +1,146 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  pool_activity_test.cpp
+
+                        pool_activity_test.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "unit.hpp"
+
+#include <extras/PoolActivity.hpp>
+#include <extras/ThreadPool.hpp>
+#include <TaskContext.hpp>
+#include <Operation.hpp>
+#include <OperationCaller.hpp>
+#include <internal/GlobalEngine.hpp>
+#include <os/fosi.h>
+#include <os/oro_arch.h>
+
+using namespace std;
+using namespace RTT;
+using namespace RTT::extras;
+
+/**
+ * Counts its steps and detects concurrent executions.
+ */
+struct CountingRunner : public base::RunnableInterface
+{
+    oro_atomic_t inside;
+    oro_atomic_t steps;
+    bool overlap, init, fini;
+
+    CountingRunner() : overlap(false), init(false), fini(false) {
+        oro_atomic_set(&inside, 0);
+        oro_atomic_set(&steps, 0);
+    }
+    bool initialize() { init = true; return true; }
+    void step() {
+        oro_atomic_inc(&inside);
+        if ( oro_atomic_read(&inside) != 1 )
+            overlap = true;
+        oro_atomic_inc(&steps);
+        usleep(100);
+        oro_atomic_dec(&inside);
+    }
+    void finalize() { fini = true; }
+    int getSteps() { return oro_atomic_read(&steps); }
+};
+
+/**
+ * A component which reports the thread its operation is executed in.
+ */
+class PooledComponent : public TaskContext
+{
+public:
+    bool in_worker;
+    PooledComponent() : TaskContext("pooled"), in_worker(false) {
+        this->addOperation("op", &PooledComponent::op, this, OwnThread);
+    }
+    int op(int i) {
+        in_worker = this->engine()->getActivity()->thread()->isSelf();
+        return i + 1;
+    }
+};
+
+class PoolActivityTest
+{
+public:
+    ThreadPoolPtr pool;
+    PoolActivityTest() : pool( new ThreadPool(3) ) {}
+};
+
+BOOST_FIXTURE_TEST_SUITE( PoolActivityTestSuite, PoolActivityTest )
+
+BOOST_AUTO_TEST_CASE( testPoolTrigger )
+{
+    const unsigned int n = 20;
+    std::vector<CountingRunner*> runners;
+    std::vector<PoolActivity*> acts;
+    BOOST_CHECK_EQUAL( pool->getWorkerCount(), 3u );
+    for (unsigned int i = 0; i != n; ++i) {
+        runners.push_back( new CountingRunner() );
+        acts.push_back( new PoolActivity(0.0, runners[i], pool) );
+        BOOST_CHECK( !acts[i]->isPeriodic() );
+        BOOST_CHECK( acts[i]->trigger() == false );
+        BOOST_CHECK( acts[i]->start() );
+        BOOST_CHECK( runners[i]->init );
+    }
+    for (unsigned int t = 0; t != 50; ++t)
+        for (unsigned int i = 0; i != n; ++i)
+            BOOST_CHECK( acts[i]->trigger() );
+    usleep(200000);
+    for (unsigned int i = 0; i != n; ++i) {
+        BOOST_CHECK( acts[i]->stop() );
+        BOOST_CHECK( !acts[i]->isActive() );
+        BOOST_CHECK( acts[i]->trigger() == false );
+        BOOST_CHECK( runners[i]->fini );
+        BOOST_CHECK( runners[i]->getSteps() >= 1 );
+        BOOST_CHECK( runners[i]->overlap == false );
+        // no steps after stop()
+        int steps = runners[i]->getSteps();
+        usleep(1000);
+        BOOST_CHECK_EQUAL( runners[i]->getSteps(), steps );
+        delete acts[i];
+        delete runners[i];
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testPoolPeriodic )
+{
+    CountingRunner runner;
+    PoolActivity act(0.01, &runner, pool);
+    BOOST_CHECK( act.isPeriodic() );
+    BOOST_CHECK_EQUAL( act.getPeriod(), 0.01 );
+    BOOST_CHECK( act.start() );
+    BOOST_CHECK( act.isRunning() );
+    usleep(200000);
+    BOOST_CHECK( act.setPeriod(0.02) );
+    BOOST_CHECK( act.setPeriod(0.0) == false );
+    BOOST_CHECK( act.stop() );
+    BOOST_CHECK( runner.getSteps() >= 5 );
+    BOOST_CHECK( runner.getSteps() <= 40 );
+    BOOST_CHECK( runner.overlap == false );
+}
+
+BOOST_AUTO_TEST_CASE( testPoolTaskContext )
+{
+    PooledComponent tc;
+    tc.setActivity( new PoolActivity(0.0, 0, pool) );
+    BOOST_CHECK( tc.start() );
+    OperationCaller<int(int)> op( tc.getOperation("op"), internal::GlobalEngine::Instance() );
+    BOOST_CHECK_EQUAL( op(3), 4 );
+    BOOST_CHECK( tc.in_worker );
+    BOOST_CHECK( tc.stop() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
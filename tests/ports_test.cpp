@@ -28,6 +28,9 @@
 
 #include <boost/function_types/function_type.hpp>
 #include <OperationCaller.hpp>
+#include <Activity.hpp>
+#include <base/RunnableInterface.hpp>
+#include <boost/scoped_ptr.hpp>
 
 using namespace std;
 using namespace RTT;
@@ -353,6 +356,227 @@ BOOST_AUTO_TEST_CASE(testPortOneWriterThreeReaders)
     BOOST_CHECK_EQUAL( rp3.read(value), NoData );
 }
 
+BOOST_AUTO_TEST_CASE(testPortSharedConnections)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1");
+    InputPort<int> rp2("R2");
+    InputPort<int> rp3("R3");
+
+    ConnPolicy policy = ConnPolicy::buffer(4);
+    policy.shared = true;
+    BOOST_REQUIRE( wp.connectTo(&rp1, policy) );
+    BOOST_REQUIRE( wp.connectTo(&rp2, policy) );
+
+    // all shared connections must use the same storage type and size.
+    ConnPolicy other = ConnPolicy::buffer(8);
+    other.shared = true;
+    BOOST_CHECK( !wp.connectTo(&rp3, other) );
+    BOOST_CHECK( !rp3.connected() );
+
+    wp.write(10);
+    wp.write(15);
+    wp.write(20);
+    BOOST_REQUIRE( wp.connectTo(&rp3, policy) );
+    wp.write(25);
+    // buffer is full for rp1 and rp2: dropped.
+    wp.write(30);
+
+    int value = 0;
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL(10, value);
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL(15, value);
+
+    // rp3 only sees the samples written after its connection.
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL(25, value);
+    BOOST_CHECK_EQUAL( rp3.read(value), OldData );
+    BOOST_CHECK_EQUAL(25, value);
+
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL(10, value);
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL(15, value);
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL(20, value);
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL(25, value);
+    BOOST_CHECK_EQUAL( rp2.read(value), OldData );
+
+    // clearing one reader does not affect the others.
+    rp1.clear();
+    BOOST_CHECK_EQUAL( rp1.read(value), NoData );
+    wp.write(35);
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL(35, value);
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL(35, value);
+
+    wp.disconnect(&rp2);
+    BOOST_CHECK( !rp2.connected() );
+    BOOST_CHECK( rp1.connected() );
+    BOOST_CHECK( rp3.connected() );
+    wp.write(40);
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL(35, value);
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL(40, value);
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL(40, value);
+
+    // a shared data connection initializes new readers with the last written value.
+    OutputPort<int> dwp("DW");
+    InputPort<int> drp1("DR1");
+    InputPort<int> drp2("DR2");
+    ConnPolicy data = ConnPolicy::data();
+    data.shared = true;
+    dwp.write(5);
+    BOOST_REQUIRE( dwp.connectTo(&drp1, data) );
+    BOOST_CHECK_EQUAL( drp1.read(value), NewData );
+    BOOST_CHECK_EQUAL(5, value);
+    dwp.write(6);
+    dwp.write(7);
+    BOOST_REQUIRE( dwp.connectTo(&drp2, data) );
+    BOOST_CHECK_EQUAL( drp2.read(value), NewData );
+    BOOST_CHECK_EQUAL(7, value);
+    BOOST_CHECK_EQUAL( drp1.read(value), NewData );
+    BOOST_CHECK_EQUAL(7, value);
+    BOOST_CHECK_EQUAL( drp1.read(value), OldData );
+    BOOST_CHECK_EQUAL( drp2.read(value), OldData );
+    BOOST_CHECK_EQUAL(7, value);
+
+    // a circular buffer which is not a power of two keeps the newest samples.
+    OutputPort<int> cwp("CW");
+    InputPort<int> crp("CR");
+    ConnPolicy circular = ConnPolicy::circularBuffer(3);
+    circular.shared = true;
+    BOOST_REQUIRE( cwp.connectTo(&crp, circular) );
+    for (int i = 0; i != 10; ++i)
+        cwp.write(i);
+    for (int i = 7; i != 10; ++i) {
+        BOOST_CHECK_EQUAL( crp.read(value), NewData );
+        BOOST_CHECK_EQUAL(i, value);
+    }
+    BOOST_CHECK_EQUAL( crp.read(value), OldData );
+}
+
+BOOST_AUTO_TEST_CASE(testPortLoanedSamples)
+{
+    OutputPort< std::vector<double> > wp("W", false);
+    InputPort< std::vector<double> > rp1("R1");
+    InputPort< std::vector<double> > rp2("R2");
+    InputPort< std::vector<double> > rp3("R3");
+
+    // without connections, the port loans its own sample.
+    std::vector<double>& first = wp.loan();
+    BOOST_CHECK( &first == &wp.loan() );
+    first.assign(4, 1.0);
+    wp.publish();
+
+    ConnPolicy policy = ConnPolicy::buffer(4);
+    policy.shared = true;
+    BOOST_REQUIRE( wp.connectTo(&rp1, policy) );
+    BOOST_REQUIRE( wp.connectTo(&rp2, policy) );
+    BOOST_REQUIRE( wp.connectTo(&rp3, ConnPolicy::data()) );
+
+    std::vector<double>& loaned = wp.loan();
+    BOOST_CHECK( &loaned != &first );
+    loaned.assign(4, 2.0);
+    wp.publish();
+
+    // the shared readers get the loaned sample in place.
+    std::vector<double> const* s1 = 0;
+    std::vector<double> const* s2 = 0;
+    BOOST_CHECK_EQUAL( rp1.take(s1), NewData );
+    BOOST_CHECK_EQUAL( rp2.take(s2), NewData );
+    BOOST_REQUIRE( s1 && s2 );
+    BOOST_CHECK( s1 == &loaned );
+    BOOST_CHECK( s2 == &loaned );
+    BOOST_CHECK_EQUAL( s1->size(), 4 );
+    BOOST_CHECK_EQUAL( (*s1)[3], 2.0 );
+    BOOST_CHECK_EQUAL( rp1.take(s1), OldData );
+    BOOST_CHECK( s1 == &loaned );
+
+    // the other connections receive a copy.
+    std::vector<double> const* s3 = 0;
+    BOOST_CHECK_EQUAL( rp3.take(s3), NewData );
+    BOOST_REQUIRE( s3 );
+    BOOST_CHECK( s3 != &loaned );
+    BOOST_CHECK_EQUAL( (*s3)[3], 2.0 );
+
+    // the next loan does not overwrite the sample which is being read.
+    wp.loan().assign(2, 3.0);
+    BOOST_CHECK_EQUAL( (*s1)[3], 2.0 );
+    wp.publish();
+    BOOST_CHECK_EQUAL( rp1.take(s1), NewData );
+    BOOST_CHECK_EQUAL( s1->size(), 2 );
+    BOOST_CHECK_EQUAL( rp2.take(s2), NewData );
+    BOOST_CHECK( s1 == s2 );
+    std::vector<double> value;
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL( value.size(), 2 );
+
+    // publishing without a loan does nothing.
+    wp.publish();
+    BOOST_CHECK_EQUAL( rp1.take(s1), OldData );
+}
+
+BOOST_AUTO_TEST_CASE(testPortBatchReadWrite)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1", ConnPolicy::buffer(4));
+    InputPort<int> rp2("R2", ConnPolicy::data());
+    InputPort<int> rp3("R3");
+
+    std::vector<int> values;
+    BOOST_CHECK_EQUAL( rp1.readAll(values), NoData );
+    BOOST_CHECK( values.empty() );
+
+    BOOST_REQUIRE( wp.createConnection(rp1) );
+    BOOST_REQUIRE( wp.createConnection(rp2) );
+    ConnPolicy shared = ConnPolicy::buffer(8);
+    shared.shared = true;
+    BOOST_REQUIRE( wp.connectTo(&rp3, shared) );
+
+    std::vector<int> batch;
+    for (int i = 1; i <= 5; ++i)
+        batch.push_back(i * 10);
+    wp.writeBatch(batch);
+    BOOST_CHECK_EQUAL( wp.getLastWrittenValue(), 50 );
+
+    // the buffer drops the samples which do not fit.
+    values.reserve(10);
+    BOOST_CHECK_EQUAL( rp1.readAll(values), NewData );
+    BOOST_REQUIRE_EQUAL( values.size(), 4 );
+    BOOST_CHECK_EQUAL( values[0], 10 );
+    BOOST_CHECK_EQUAL( values[3], 40 );
+    BOOST_CHECK_EQUAL( values.capacity(), 10 );
+    BOOST_CHECK_EQUAL( rp1.readAll(values), OldData );
+    BOOST_CHECK( values.empty() );
+    int value = 0;
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+    BOOST_CHECK_EQUAL( value, 40 );
+
+    // a data connection only keeps the last sample.
+    BOOST_CHECK_EQUAL( rp2.readAll(values), NewData );
+    BOOST_REQUIRE_EQUAL( values.size(), 1 );
+    BOOST_CHECK_EQUAL( values[0], 50 );
+
+    BOOST_CHECK_EQUAL( rp3.readAll(values), NewData );
+    BOOST_REQUIRE_EQUAL( values.size(), 5 );
+    BOOST_CHECK_EQUAL( values[4], 50 );
+
+    // all connections of an input port are read.
+    OutputPort<int> wp2("W2");
+    BOOST_REQUIRE( wp2.createConnection(rp1) );
+    wp.write(60);
+    wp2.write(70);
+    BOOST_CHECK_EQUAL( rp1.readAll(values), NewData );
+    BOOST_REQUIRE_EQUAL( values.size(), 2 );
+    BOOST_CHECK( (values[0] == 60 && values[1] == 70) || (values[0] == 70 && values[1] == 60) );
+}
+
 BOOST_AUTO_TEST_CASE(testPortThreeWritersOneReader)
 {
     OutputPort<int> wp1("W1");
@@ -582,6 +806,65 @@ BOOST_AUTO_TEST_CASE(testPortAddRemove)
     tc.stop();
 }
 
+/**
+ * Writes an OutputPort until it is stopped.
+ */
+struct PortWriter : public RunnableInterface
+{
+    volatile bool stop;
+    OutputPort<int>& port;
+    int writes;
+    PortWriter(OutputPort<int>& port) : stop(false), port(port), writes(0) {}
+    bool initialize() {
+        stop = false; writes = 0;
+        return true;
+    }
+    void step() {
+        while (stop == false) {
+            port.write(++writes);
+        }
+    }
+    void finalize() {}
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(testPortConnectWhileWriting)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1");
+    InputPort<int> rp2("R2", ConnPolicy::buffer(4));
+    PortWriter writer(wp);
+    boost::scoped_ptr<Activity> wthread( new Activity(ORO_SCHED_OTHER, 0, 0, &writer, "PortWriter" ));
+
+    BOOST_REQUIRE( wp.createConnection(rp1) );
+    BOOST_REQUIRE( wthread->start() );
+    for (int i = 0; i != 1000 && writer.writes == 0; ++i)
+        usleep(1000);
+
+    // The writer never blocks on (dis)connecting and
+    // always writes into the connections which remain.
+    int value = 0, last = 0;
+    for (int i = 0; i != 200; ++i) {
+        BOOST_REQUIRE( wp.createConnection(rp2) );
+        BOOST_CHECK( rp2.connected() );
+        rp2.disconnect();
+        BOOST_CHECK( !rp2.connected() );
+        if ( rp1.read(value) == NewData ) {
+            BOOST_CHECK( value > last );
+            last = value;
+        }
+    }
+    BOOST_CHECK( wthread->stop() );
+    BOOST_CHECK( writer.writes > 0 );
+    BOOST_CHECK( rp1.read(value) != NoData );
+    BOOST_CHECK_EQUAL( writer.writes, value );
+    BOOST_CHECK( wp.connected() );
+    BOOST_CHECK( !rp2.connected() );
+}
+
 BOOST_AUTO_TEST_CASE(testEventPortSignalling)
 {
     OutputPort<double> wp1("Write");
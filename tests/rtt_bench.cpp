@@ -0,0 +1,445 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  rtt_bench.cpp
+
+                        rtt_bench.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/**
+ * @file rtt_bench.cpp
+ * Latency benchmarks of the data flow primitives and of os::Timer.
+ *
+ * Each benchmark runs a number of threads on one shared primitive and
+ * records the duration of every operation. The percentiles are printed
+ * as CSV on standard output, one line per benchmark, thread count and
+ * sample size, such that results can be compared between releases:
+ *
+ * @verbatim
+ * rtt-bench [operations per thread] > results.csv
+ * @endverbatim
+ */
+
+#include <os/main.h>
+#include <os/TimeService.hpp>
+#include <os/Timer.hpp>
+#include <os/oro_arch.h>
+#include <base/RunnableInterface.hpp>
+#include <base/BufferLockFree.hpp>
+#include <base/BufferLocked.hpp>
+#include <base/DataObjectLockFree.hpp>
+#include <internal/AtomicMWSRQueue.hpp>
+#include <internal/TsPool.hpp>
+#include <InputPort.hpp>
+#include <OutputPort.hpp>
+#include <Activity.hpp>
+#include <Logger.hpp>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+using namespace RTT;
+
+typedef os::TimeService::nsecs nsecs;
+typedef std::vector<nsecs> Latencies;
+
+// A benchmark which did not finish within this time is stopped.
+#define BENCH_TIMEOUT_SECS 10
+
+// The number of armed timers in the Timer benchmarks.
+#define BENCH_TIMERS 10000
+
+static inline nsecs now()
+{
+    return os::TimeService::Instance()->getNSecs();
+}
+
+/**
+ * A sample of \a N bytes, which carries the time it was written.
+ */
+template<int N>
+struct Sample
+{
+    nsecs stamp;
+    char data[N - sizeof(nsecs)];
+};
+
+/**
+ * Calls op until it recorded \a count latencies or
+ * until it is stopped. A worker with a zero count
+ * runs until it is stopped.
+ */
+struct BenchWorker : public base::RunnableInterface
+{
+    boost::function<bool(Latencies&)> op;
+    unsigned int count;
+    Latencies latencies;
+    volatile bool stop;
+    oro_atomic_t* busy;
+
+    BenchWorker(boost::function<bool(Latencies&)> op, unsigned int count, oro_atomic_t* busy)
+        : op(op), count(count), stop(false), busy(busy)
+    {
+        latencies.reserve(count);
+    }
+    bool initialize() {
+        stop = false;
+        return true;
+    }
+    void step() {
+        while ( stop == false && (count == 0 || latencies.size() < count) )
+            op(latencies);
+        if ( count )
+            oro_atomic_dec(busy);
+    }
+    void finalize() {}
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+/**
+ * Records the duration of each successful call of \a F.
+ */
+template<class F>
+struct Timed
+{
+    F f;
+    Timed(F f) : f(f) {}
+    bool operator()(Latencies& l) {
+        nsecs start = now();
+        if ( !f() )
+            return false;
+        l.push_back( now() - start );
+        return true;
+    }
+};
+
+template<class F>
+Timed<F> timed(F f) { return Timed<F>(f); }
+
+template<class T>
+struct BufferPushPop
+{
+    base::BufferInterface<T>* buffer;
+    T sample;
+    BufferPushPop(base::BufferInterface<T>* b) : buffer(b), sample() {}
+    bool operator()() {
+        buffer->Push(sample);
+        buffer->Pop(sample);
+        return true;
+    }
+};
+
+template<class T>
+struct DataObjectSet
+{
+    base::DataObjectInterface<T>* dobj;
+    T sample;
+    DataObjectSet(base::DataObjectInterface<T>* d) : dobj(d), sample() {}
+    bool operator()() { dobj->Set(sample); return true; }
+};
+
+template<class T>
+struct DataObjectGet
+{
+    base::DataObjectInterface<T>* dobj;
+    T sample;
+    DataObjectGet(base::DataObjectInterface<T>* d) : dobj(d), sample() {}
+    bool operator()() { dobj->Get(sample); return true; }
+};
+
+template<class T>
+struct QueueEnqueue
+{
+    internal::AtomicMWSRQueue<T*>* queue;
+    T sample;
+    QueueEnqueue(internal::AtomicMWSRQueue<T*>* q) : queue(q), sample() {}
+    bool operator()() { return queue->enqueue(&sample); }
+};
+
+template<class T>
+struct QueueDequeue
+{
+    internal::AtomicMWSRQueue<T*>* queue;
+    QueueDequeue(internal::AtomicMWSRQueue<T*>* q) : queue(q) {}
+    bool operator()() { T* s; return queue->dequeue(s); }
+};
+
+template<class T>
+struct PoolAllocateDeallocate
+{
+    internal::TsPool<T>* pool;
+    PoolAllocateDeallocate(internal::TsPool<T>* p) : pool(p) {}
+    bool operator()() { return pool->deallocate( pool->allocate() ); }
+};
+
+/**
+ * Writes time stamped samples until it is stopped.
+ */
+template<class T>
+struct PortWrite
+{
+    OutputPort<T>* port;
+    T sample;
+    PortWrite(OutputPort<T>* p) : port(p), sample() {}
+    bool operator()(Latencies&) {
+        sample.stamp = now();
+        port->write(sample);
+        return true;
+    }
+};
+
+/**
+ * Records the time between writing and reading each new sample.
+ */
+template<class T>
+struct PortRead
+{
+    InputPort<T>* port;
+    T sample;
+    PortRead(InputPort<T>* p) : port(p), sample() {}
+    bool operator()(Latencies& l) {
+        if ( port->read(sample, false) != NewData )
+            return false;
+        l.push_back( now() - sample.stamp );
+        return true;
+    }
+};
+
+/**
+ * Picks pseudo-random timer ids.
+ */
+struct TimerIdGenerator
+{
+    unsigned int state;
+    TimerIdGenerator(unsigned int seed) : state(seed) {}
+    os::Timer::TimerId operator()() {
+        state = state * 1103515245u + 12345u;
+        return (state >> 8) % BENCH_TIMERS;
+    }
+};
+
+/**
+ * Re-arms a random timer, which moves it in the timer queue.
+ */
+struct TimerArm
+{
+    os::Timer* timer;
+    TimerIdGenerator ids;
+    TimerArm(os::Timer* t, unsigned int seed) : timer(t), ids(seed) {}
+    bool operator()() {
+        os::Timer::TimerId id = ids();
+        return timer->arm( id, 100.0 + id * 0.001 );
+    }
+};
+
+/**
+ * Kills a random timer and arms it again, only the
+ * killTimer() call is measured.
+ */
+struct TimerKill
+{
+    os::Timer* timer;
+    TimerIdGenerator ids;
+    TimerKill(os::Timer* t, unsigned int seed) : timer(t), ids(seed) {}
+    bool operator()(Latencies& l) {
+        os::Timer::TimerId id = ids();
+        nsecs start = now();
+        if ( !timer->killTimer(id) )
+            return false;
+        l.push_back( now() - start );
+        return timer->arm( id, 100.0 + id * 0.001 );
+    }
+};
+
+/**
+ * Runs all workers concurrently, waits until the ones with a count
+ * finished and prints the percentiles of all their latencies.
+ */
+static void runBench(const string& name, unsigned int threads, unsigned int sample_size,
+                     vector< boost::shared_ptr<BenchWorker> >& workers, oro_atomic_t* busy)
+{
+    vector< boost::shared_ptr<Activity> > activities;
+    for (unsigned int i = 0; i != workers.size(); ++i)
+        activities.push_back( boost::shared_ptr<Activity>( new Activity(ORO_SCHED_OTHER, 0, 0, workers[i].get(), name) ) );
+    for (unsigned int i = 0; i != activities.size(); ++i)
+        activities[i]->start();
+
+    nsecs deadline = now() + nsecs(BENCH_TIMEOUT_SECS) * 1000000000LL;
+    while ( oro_atomic_read(busy) > 0 && now() < deadline )
+        usleep(1000);
+    if ( oro_atomic_read(busy) > 0 )
+        log(Warning) << name << " did not finish within " << BENCH_TIMEOUT_SECS << " seconds." << endlog();
+
+    for (unsigned int i = 0; i != activities.size(); ++i)
+        activities[i]->stop();
+
+    Latencies all;
+    for (unsigned int i = 0; i != workers.size(); ++i)
+        all.insert( all.end(), workers[i]->latencies.begin(), workers[i]->latencies.end() );
+    if ( all.empty() )
+        return;
+    sort( all.begin(), all.end() );
+    cout << name << "," << threads << "," << sample_size << "," << all.size() << ","
+         << all[ all.size() * 50 / 100 ] << ","
+         << all[ all.size() * 99 / 100 ] << ","
+         << all[ all.size() * 999 / 1000 ] << ","
+         << all.back() << endl;
+}
+
+template<class T>
+static void benchBuffer(const string& name, base::BufferInterface<T>* buffer, unsigned int threads, unsigned int count)
+{
+    oro_atomic_t busy;
+    oro_atomic_set(&busy, threads);
+    vector< boost::shared_ptr<BenchWorker> > workers;
+    for (unsigned int i = 0; i != threads; ++i)
+        workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( timed( BufferPushPop<T>(buffer) ), count, &busy ) ) );
+    runBench(name, threads, sizeof(T), workers, &busy);
+}
+
+/**
+ * One writer and threads - 1 readers.
+ */
+template<class T>
+static void benchDataObject(unsigned int threads, unsigned int count)
+{
+    base::DataObjectLockFree<T> dobj( T(), threads + 1 );
+    oro_atomic_t busy;
+    oro_atomic_set(&busy, threads);
+    vector< boost::shared_ptr<BenchWorker> > workers;
+    workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( timed( DataObjectSet<T>(&dobj) ), count, &busy ) ) );
+    for (unsigned int i = 1; i < threads; ++i)
+        workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( timed( DataObjectGet<T>(&dobj) ), count, &busy ) ) );
+    runBench("DataObjectLockFree", threads, sizeof(T), workers, &busy);
+}
+
+/**
+ * threads - 1 writers and one reader, hence it needs at least two threads.
+ */
+template<class T>
+static void benchMWSRQueue(unsigned int threads, unsigned int count)
+{
+    if ( threads < 2 )
+        return;
+    internal::AtomicMWSRQueue<T*> queue( 64 );
+    unsigned int writers = threads - 1;
+    oro_atomic_t busy;
+    oro_atomic_set(&busy, writers + 1);
+    vector< boost::shared_ptr<BenchWorker> > workers;
+    for (unsigned int i = 0; i != writers; ++i)
+        workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( timed( QueueEnqueue<T>(&queue) ), count, &busy ) ) );
+    workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( timed( QueueDequeue<T>(&queue) ), count * writers, &busy ) ) );
+    runBench("AtomicMWSRQueue", threads, sizeof(T), workers, &busy);
+}
+
+template<class T>
+static void benchPool(unsigned int threads, unsigned int count)
+{
+    internal::TsPool<T> pool( threads );
+    oro_atomic_t busy;
+    oro_atomic_set(&busy, threads);
+    vector< boost::shared_ptr<BenchWorker> > workers;
+    for (unsigned int i = 0; i != threads; ++i)
+        workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( timed( PoolAllocateDeallocate<T>(&pool) ), count, &busy ) ) );
+    runBench("TsPool", threads, sizeof(T), workers, &busy);
+}
+
+/**
+ * One writer and threads - 1 readers, each reading its own InputPort,
+ * hence it needs at least two threads.
+ */
+template<class T>
+static void benchPorts(unsigned int threads, unsigned int count)
+{
+    if ( threads < 2 )
+        return;
+    unsigned int readers = threads - 1;
+    OutputPort<T> output("out");
+    output.setDataSample( T() );
+    vector< boost::shared_ptr< InputPort<T> > > inputs;
+    for (unsigned int i = 0; i != readers; ++i) {
+        inputs.push_back( boost::shared_ptr< InputPort<T> >( new InputPort<T>("in") ) );
+        output.createConnection( *inputs.back() );
+    }
+    oro_atomic_t busy;
+    oro_atomic_set(&busy, readers);
+    vector< boost::shared_ptr<BenchWorker> > workers;
+    workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( PortWrite<T>(&output), 0, &busy ) ) );
+    for (unsigned int i = 0; i != readers; ++i)
+        workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( PortRead<T>(inputs[i].get()), count, &busy ) ) );
+    runBench("OutputPort->InputPort", threads, sizeof(T), workers, &busy);
+    output.disconnect();
+}
+
+/**
+ * Arms and kills timers of a Timer which holds BENCH_TIMERS armed timers.
+ * The sample_bytes column holds the number of timers.
+ */
+static void benchTimers(unsigned int threads, unsigned int count)
+{
+    os::Timer timer(BENCH_TIMERS, ORO_SCHED_OTHER);
+    for (unsigned int i = 0; i != BENCH_TIMERS; ++i)
+        timer.arm(i, 100.0 + i * 0.001);
+
+    oro_atomic_t busy;
+    oro_atomic_set(&busy, threads);
+    vector< boost::shared_ptr<BenchWorker> > workers;
+    for (unsigned int i = 0; i != threads; ++i)
+        workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( timed( TimerArm(&timer, i + 1) ), count, &busy ) ) );
+    runBench("Timer::arm", threads, BENCH_TIMERS, workers, &busy);
+
+    oro_atomic_set(&busy, threads);
+    workers.clear();
+    for (unsigned int i = 0; i != threads; ++i)
+        workers.push_back( boost::shared_ptr<BenchWorker>( new BenchWorker( TimerKill(&timer, i + 1), count, &busy ) ) );
+    runBench("Timer::killTimer", threads, BENCH_TIMERS, workers, &busy);
+}
+
+template<class T>
+static void benchSampleSize(unsigned int threads, unsigned int count)
+{
+    base::BufferLockFree<T> lockfree( 64 * threads );
+    benchBuffer<T>("BufferLockFree", &lockfree, threads, count);
+    base::BufferLocked<T> locked( 64 * threads );
+    benchBuffer<T>("BufferLocked", &locked, threads, count);
+    benchDataObject<T>(threads, count);
+    benchMWSRQueue<T>(threads, count);
+    benchPool<T>(threads, count);
+    benchPorts<T>(threads, count);
+}
+
+int ORO_main(int argc, char** argv)
+{
+    unsigned int count = 10000;
+    if ( argc > 1 )
+        count = atoi( argv[1] );
+
+    cout << "benchmark,threads,sample_bytes,operations,p50_ns,p99_ns,p99.9_ns,max_ns" << endl;
+    unsigned int threads[] = { 1, 2, 4 };
+    for (unsigned int i = 0; i != sizeof(threads) / sizeof(threads[0]); ++i) {
+        benchSampleSize< Sample<16> >(threads[i], count);
+        benchSampleSize< Sample<256> >(threads[i], count);
+        benchSampleSize< Sample<4096> >(threads[i], count);
+        benchTimers(threads[i], count);
+    }
+    return 0;
+}
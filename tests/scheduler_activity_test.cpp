@@ -0,0 +1,173 @@
+/***************************************************************************
+  tag: Orocos Developers  Sat Oct 17 2026  scheduler_activity_test.cpp
+
+                        scheduler_activity_test.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 Orocos Developers
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "unit.hpp"
+
+#include <extras/SchedulerActivity.hpp>
+#include <TaskContext.hpp>
+#include <InputPort.hpp>
+#include <OutputPort.hpp>
+#include <os/fosi.h>
+
+using namespace std;
+using namespace RTT;
+using namespace RTT::extras;
+
+/**
+ * A component which records when it was executed.
+ */
+class Stage : public TaskContext
+{
+public:
+    static int counter;
+    OutputPort<int> out;
+    InputPort<int> in;
+    int order;
+    int delay;
+    Stage(const std::string& name, int delay_us = 0)
+        : TaskContext(name), out("out"), in("in"), order(0), delay(delay_us)
+    {
+        this->ports()->addPort(out);
+        this->ports()->addPort(in);
+    }
+    void updateHook() {
+        order = ++counter;
+        if (delay)
+            usleep(delay);
+    }
+};
+
+int Stage::counter = 0;
+
+/**
+ * A component which queries its own scheduler.
+ */
+class Monitor : public TaskContext
+{
+public:
+    SchedulerActivity* sched;
+    int queries;
+    Monitor(SchedulerActivity* s)
+        : TaskContext("monitor"), sched(s), queries(0)
+    {}
+    void updateHook() {
+        sched->getDeadlineMisses(this);
+        sched->getCompletionTime(this);
+        sched->getSchedule();
+        ++queries;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( SchedulerActivityTestSuite )
+
+BOOST_AUTO_TEST_CASE( testDataFlowOrder )
+{
+    // destroyed after the components.
+    SchedulerActivity sched(ORO_SCHED_OTHER, os::LowestPriority, 0.01);
+    Stage sense("sense"), control("control"), actuate("actuate");
+    BOOST_REQUIRE( sense.out.connectTo(&control.in) );
+    BOOST_REQUIRE( control.out.connectTo(&actuate.in) );
+
+    BOOST_CHECK( sched.addComponent(&sense) == false );
+    BOOST_REQUIRE( sched.start() );
+    BOOST_CHECK( sched.addComponent(&actuate) );
+    BOOST_CHECK( sched.addComponent(&control) );
+    BOOST_CHECK( sched.addComponent(&sense) );
+    BOOST_CHECK( sched.addComponent(&sense) == false );
+
+    std::vector< std::vector<TaskContext*> > schedule = sched.getSchedule();
+    BOOST_REQUIRE_EQUAL( schedule.size(), 1u );
+    BOOST_REQUIRE_EQUAL( schedule[0].size(), 3u );
+    BOOST_CHECK( schedule[0][0] == &sense );
+    BOOST_CHECK( schedule[0][1] == &control );
+    BOOST_CHECK( schedule[0][2] == &actuate );
+
+    BOOST_CHECK( actuate.start() );
+    BOOST_CHECK( control.start() );
+    BOOST_CHECK( sense.start() );
+    usleep(100000);
+    BOOST_CHECK( sense.order != 0 );
+    BOOST_CHECK( sense.order < control.order );
+    BOOST_CHECK( control.order < actuate.order );
+    BOOST_CHECK( sched.stop() );
+}
+
+BOOST_AUTO_TEST_CASE( testParallelBranches )
+{
+    SchedulerActivity sched(ORO_SCHED_OTHER, os::LowestPriority, 0.01);
+    Stage a1("a1"), a2("a2"), b1("b1"), b2("b2");
+    BOOST_REQUIRE( a1.out.connectTo(&a2.in) );
+    BOOST_REQUIRE( b1.out.connectTo(&b2.in) );
+
+    BOOST_CHECK( sched.setParallel( std::vector<unsigned>(1, ~0) ) );
+    BOOST_REQUIRE( sched.start() );
+    BOOST_CHECK( sched.setParallel( std::vector<unsigned>() ) == false );
+    BOOST_CHECK( sched.addComponent(&a2) );
+    BOOST_CHECK( sched.addComponent(&b2) );
+    BOOST_CHECK( sched.addComponent(&a1) );
+    BOOST_CHECK( sched.addComponent(&b1) );
+
+    std::vector< std::vector<TaskContext*> > schedule = sched.getSchedule();
+    BOOST_REQUIRE_EQUAL( schedule.size(), 2u );
+    BOOST_REQUIRE_EQUAL( schedule[0].size(), 2u );
+    BOOST_REQUIRE_EQUAL( schedule[1].size(), 2u );
+    BOOST_CHECK( schedule[0][0] == &a1 );
+    BOOST_CHECK( schedule[0][1] == &a2 );
+    BOOST_CHECK( schedule[1][0] == &b1 );
+    BOOST_CHECK( schedule[1][1] == &b2 );
+
+    BOOST_CHECK( a1.start() && a2.start() && b1.start() && b2.start() );
+    usleep(100000);
+    BOOST_CHECK( a2.order != 0 );
+    BOOST_CHECK( b2.order != 0 );
+    BOOST_CHECK( sched.stop() );
+}
+
+BOOST_AUTO_TEST_CASE( testDeadlineMisses )
+{
+    SchedulerActivity sched(ORO_SCHED_OTHER, os::LowestPriority, 0.01);
+    Stage slow("slow", 5000), fast("fast");
+    BOOST_REQUIRE( sched.start() );
+    BOOST_CHECK( sched.addComponent(&slow, 0.001) );
+    BOOST_CHECK( sched.addComponent(&fast) );
+    BOOST_CHECK( slow.start() && fast.start() );
+    usleep(100000);
+    BOOST_CHECK( sched.stop() );
+    BOOST_CHECK( sched.getDeadlineMisses(&slow) > 0 );
+    BOOST_CHECK_EQUAL( sched.getDeadlineMisses(&fast), 0u );
+    BOOST_CHECK( sched.getCompletionTime(&fast) >= 0.005 );
+}
+
+BOOST_AUTO_TEST_CASE( testQueryFromComponent )
+{
+    SchedulerActivity sched(ORO_SCHED_OTHER, os::LowestPriority, 0.01);
+    Monitor monitor(&sched);
+    Stage late("late");
+    BOOST_REQUIRE( sched.start() );
+    BOOST_CHECK( sched.addComponent(&monitor) );
+    BOOST_CHECK( monitor.start() );
+    usleep(50000);
+    // adding a component while the cycle runs must not disturb it.
+    BOOST_CHECK( sched.addComponent(&late) );
+    BOOST_CHECK( late.start() );
+    usleep(50000);
+    BOOST_CHECK( sched.stop() );
+    BOOST_CHECK( monitor.queries > 1 );
+    BOOST_CHECK( late.order != 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
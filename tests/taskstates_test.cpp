@@ -19,6 +19,8 @@
 #include "unit.hpp"
 
 #include <iostream>
+#include <set>
+#include <pthread.h>
 
 #include <TaskContext.hpp>
 #include <extras/SlaveActivity.hpp>
@@ -28,6 +30,9 @@
 
 #include <boost/function_types/function_type.hpp>
 #include <OperationCaller.hpp>
+#include <Activity.hpp>
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
 
 using namespace std;
 using namespace RTT;
@@ -35,6 +40,17 @@ using namespace RTT::detail;
 
 struct A {};
 
+/**
+ * A message which counts its executions.
+ */
+struct CountingMessage : public base::DisposableInterface
+{
+    int executed;
+    CountingMessage() : executed(0) {}
+    void executeAndDispose() { ++executed; }
+    void dispose() {}
+};
+
 
 // Test TaskContext states.
 class StatesTC
@@ -169,6 +185,64 @@ public:
     int  updatecount;
 };
 
+/**
+ * Calls an operation of another component in its updateHook().
+ */
+class RemoteCallerTC
+    : public RTT::TaskContext
+{
+public:
+    OperationCaller<int(int)> remote;
+    int calls;
+    int failures;
+
+    RemoteCallerTC(OperationInterfacePart* op)
+        : TaskContext("RemoteCallerTC"), remote(op, this->engine()), calls(0), failures(0)
+    {}
+
+    void updateHook() {
+        for (int i = 0; i != 1000; ++i) {
+            if ( remote(i) != i )
+                ++failures;
+            ++calls;
+        }
+    }
+};
+
+/**
+ * Offers an operation executed in its own thread.
+ */
+class EchoTC
+    : public RTT::TaskContext
+{
+public:
+    EchoTC()
+        : TaskContext("EchoTC")
+    {
+        this->addOperation("echo", &EchoTC::echo, this, OwnThread);
+    }
+
+    int echo(int i) { return i; }
+};
+
+/**
+ * Waits in another thread than the engine's until go is set.
+ */
+struct MessageWaiter : public base::RunnableInterface
+{
+    ExecutionEngine* ee;
+    volatile bool go;
+    volatile bool woken;
+    MessageWaiter(ExecutionEngine* e) : ee(e), go(false), woken(false) {}
+    bool ready() { return go; }
+    bool initialize() { return true; }
+    void step() {
+        ee->waitForMessages( boost::bind(&MessageWaiter::ready, this) );
+        woken = true;
+    }
+    void finalize() {}
+};
+
 /**
  * Fixture.
  */
@@ -637,5 +711,227 @@ BOOST_AUTO_TEST_CASE( testExecutionEngine)
     tsim->run(0);
 }
 
+/**
+ * A child TaskCore which records the threads executing it.
+ */
+struct ThreadRecordingCore : public TaskCore
+{
+    static os::Mutex lock;
+    static std::set<pthread_t> threads;
+    int updates;
+    ThreadRecordingCore(ExecutionEngine* ee) : TaskCore(ee), updates(0) {}
+    void updateHook() {
+        ++updates;
+        os::MutexLock l(lock);
+        threads.insert( pthread_self() );
+    }
+};
+
+os::Mutex ThreadRecordingCore::lock;
+std::set<pthread_t> ThreadRecordingCore::threads;
+
+/**
+ * A child which tries to change the helper threads of its engine.
+ */
+struct ReconfiguringCore : public TaskCore
+{
+    bool result;
+    ReconfiguringCore(ExecutionEngine* ee) : TaskCore(ee), result(true) {}
+    void updateHook() {
+        result = this->engine()->setParallelChildren(0);
+    }
+};
+
+BOOST_AUTO_TEST_CASE( testParallelChildren )
+{
+    TaskContext owner("ParallelTC");
+    owner.setActivity( new SlaveActivity(0.1) );
+    BOOST_CHECK( owner.engine()->setParallelChildren(2) );
+    BOOST_CHECK_EQUAL( owner.engine()->getParallelChildren(), 2u );
+    {
+        std::vector<ThreadRecordingCore*> cores;
+        for (int i = 0; i != 6; ++i) {
+            cores.push_back( new ThreadRecordingCore( owner.engine() ) );
+            BOOST_CHECK( cores[i]->start() );
+        }
+        ReconfiguringCore reconfiguring( owner.engine() );
+        BOOST_CHECK( reconfiguring.start() );
+        BOOST_CHECK( owner.start() );
+        for (int c = 0; c != 10; ++c)
+            BOOST_CHECK( owner.getActivity()->execute() );
+        // the helpers can not be replaced from within a cycle.
+        BOOST_CHECK( reconfiguring.result == false );
+        BOOST_CHECK_EQUAL( owner.engine()->getParallelChildren(), 2u );
+        // every child executes once per cycle, spread over three threads.
+        for (int i = 0; i != 6; ++i) {
+            BOOST_CHECK_EQUAL( cores[i]->updates, 10 );
+            delete cores[i];
+        }
+        BOOST_CHECK_EQUAL( ThreadRecordingCore::threads.size(), 3u );
+    }
+    BOOST_CHECK( owner.stop() );
+    BOOST_CHECK( owner.engine()->setParallelChildren(0) );
+    BOOST_CHECK_EQUAL( owner.engine()->getParallelChildren(), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( testExecutionStatistics )
+{
+    TaskContext stattc("StatTC");
+    stattc.setActivity( new SlaveActivity(0.1) );
+    BOOST_CHECK( stattc.provides()->hasOperation("getExecutionStatistics") );
+    BOOST_CHECK( stattc.engine()->isStatisticsEnabled() == false );
+    BOOST_CHECK( stattc.start() );
+
+    // nothing is measured when disabled.
+    BOOST_CHECK( stattc.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( stattc.engine()->getStatistics().phases[ExecutionStatistics::Cycle].count, 0u );
+
+    stattc.setExecutionStatisticsEnabled(true);
+    for (int i = 0; i != 10; ++i)
+        BOOST_CHECK( stattc.getActivity()->execute() );
+
+    ExecutionStatistics stats = stattc.engine()->getStatistics();
+    for (int p = 0; p != ExecutionStatistics::PhaseCount; ++p) {
+        PhaseStatistics& phase = stats.phases[p];
+        BOOST_CHECK_EQUAL( phase.count, 10u );
+        BOOST_CHECK( phase.min <= phase.mean() );
+        BOOST_CHECK( phase.mean() <= phase.max );
+        unsigned long binned = 0;
+        for (unsigned int b = 0; b != PhaseStatistics::HISTOGRAM_SIZE; ++b)
+            binned += phase.histogram[b];
+        BOOST_CHECK_EQUAL( binned, 10u );
+    }
+    BOOST_CHECK( stats.phases[ExecutionStatistics::Cycle].total >= stats.phases[ExecutionStatistics::UpdateHook].total );
+    BOOST_CHECK( stattc.getExecutionStatistics().find("updateHook: count 10") != string::npos );
+
+    stattc.resetExecutionStatistics();
+    BOOST_CHECK_EQUAL( stattc.engine()->getStatistics().phases[ExecutionStatistics::Cycle].count, 0u );
+    BOOST_CHECK( stattc.stop() );
+}
+
+BOOST_AUTO_TEST_CASE( testQueueSize )
+{
+    CountingMessage msg;
+    int accepted = 0;
+
+    // a fixed queue refuses messages when it is full.
+    TaskContext fixedtc("FixedTC", TaskCore::Stopped, 4);
+    fixedtc.setActivity( new SlaveActivity(0.1) );
+    BOOST_CHECK( fixedtc.start() );
+    for (int i = 0; i != 20; ++i)
+        accepted += fixedtc.engine()->process(&msg) ? 1 : 0;
+    BOOST_CHECK_EQUAL( accepted, 4 );
+    BOOST_CHECK( fixedtc.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( msg.executed, 4 );
+    BOOST_CHECK( fixedtc.stop() );
+
+    // a growable queue accepts the burst.
+    msg.executed = accepted = 0;
+    TaskContext growtc("GrowTC", TaskCore::Stopped, 4, true);
+    growtc.setActivity( new SlaveActivity(0.1) );
+    BOOST_CHECK( growtc.start() );
+    for (int i = 0; i != 20; ++i)
+        accepted += growtc.engine()->process(&msg) ? 1 : 0;
+#ifndef OROBLD_OS_NO_ASM
+    BOOST_CHECK_EQUAL( accepted, 20 );
+#endif
+    BOOST_CHECK( growtc.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( msg.executed, accepted );
+    BOOST_CHECK( growtc.stop() );
+}
+
+BOOST_AUTO_TEST_CASE( testMessageCoalescing )
+{
+    CountingMessage msg;
+    TaskContext tc("CoalescingTC");
+    tc.setActivity( new SlaveActivity(0.1) );
+    BOOST_CHECK( tc.start() );
+    BOOST_CHECK( tc.engine()->getMessageCoalescing() == false );
+
+    // without coalescing, every message wakes up the engine.
+    for (int i = 0; i != 10; ++i)
+        BOOST_CHECK( tc.engine()->process(&msg) );
+    BOOST_CHECK_EQUAL( tc.engine()->getSuppressedWakeups(), 0u );
+    BOOST_CHECK( tc.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( msg.executed, 10 );
+
+    // only the first message of a burst wakes up the engine.
+    tc.engine()->setMessageCoalescing(true);
+    BOOST_CHECK( tc.engine()->getMessageCoalescing() );
+    msg.executed = 0;
+    for (int i = 0; i != 10; ++i)
+        BOOST_CHECK( tc.engine()->process(&msg) );
+    BOOST_CHECK_EQUAL( tc.engine()->getSuppressedWakeups(), 9u );
+    BOOST_CHECK( tc.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( msg.executed, 10 );
+
+    // once the queue was processed, the next message wakes it up again.
+    BOOST_CHECK( tc.engine()->process(&msg) );
+    BOOST_CHECK_EQUAL( tc.engine()->getSuppressedWakeups(), 9u );
+    BOOST_CHECK( tc.engine()->process(&msg) );
+    BOOST_CHECK_EQUAL( tc.engine()->getSuppressedWakeups(), 10u );
+    BOOST_CHECK( tc.getActivity()->execute() );
+    BOOST_CHECK_EQUAL( msg.executed, 12 );
+    BOOST_CHECK( tc.stop() );
+}
+
+BOOST_AUTO_TEST_CASE( testMessageCoalescingWaiters )
+{
+    // the engine is not executed, so only process() can wake up the waiters.
+    CountingMessage msg;
+    TaskContext tc("WaitingTC");
+    tc.setActivity( new SlaveActivity(0.1) );
+    BOOST_CHECK( tc.start() );
+    tc.engine()->setMessageCoalescing(true);
+    MessageWaiter a( tc.engine() ), b( tc.engine() );
+    {
+        boost::scoped_ptr<Activity> athread( new Activity(ORO_SCHED_OTHER, 0, 0, &a, "WaiterA" ));
+        boost::scoped_ptr<Activity> bthread( new Activity(ORO_SCHED_OTHER, 0, 0, &b, "WaiterB" ));
+        BOOST_CHECK( athread->start() );
+        BOOST_CHECK( bthread->start() );
+        usleep(100000);
+        a.go = true;
+        BOOST_CHECK( tc.engine()->process(&msg) );
+        for (int i = 0; i != 100 && !a.woken; ++i)
+            usleep(10000);
+        BOOST_CHECK( a.woken );
+        BOOST_CHECK( b.woken == false );
+
+        // the engine did not process the first message yet.
+        b.go = true;
+        BOOST_CHECK( tc.engine()->process(&msg) );
+        BOOST_CHECK_EQUAL( tc.engine()->getSuppressedWakeups(), 1u );
+        for (int i = 0; i != 100 && !b.woken; ++i)
+            usleep(10000);
+        BOOST_CHECK( b.woken );
+
+        // processing the messages releases a waiter which was not woken up.
+        BOOST_CHECK( tc.getActivity()->execute() );
+        BOOST_CHECK_EQUAL( msg.executed, 2 );
+        athread->stop();
+        bthread->stop();
+    }
+    BOOST_CHECK( tc.stop() );
+}
+
+BOOST_AUTO_TEST_CASE( testMessageCoalescingRemoteCall )
+{
+    // the replies of the remote operation arrive while the caller waits
+    // for them in waitAndProcessMessages().
+    EchoTC echo;
+    RemoteCallerTC caller( echo.getOperation("echo") );
+    echo.engine()->setMessageCoalescing(true);
+    caller.engine()->setMessageCoalescing(true);
+    BOOST_CHECK( echo.start() );
+    BOOST_CHECK( caller.start() );
+    BOOST_CHECK( caller.trigger() );
+    for (int i = 0; i != 1000 && caller.calls < 1000; ++i)
+        usleep(10000);
+    BOOST_REQUIRE( caller.calls >= 1000 );
+    BOOST_CHECK( caller.stop() );
+    BOOST_CHECK_EQUAL( caller.failures, 0 );
+    BOOST_CHECK( echo.stop() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -123,6 +123,61 @@ struct TestFileDescriptor
 	int fd[2];	// from pipe()
 };
 
+/**
+ * Records the file descriptors of each step and reads one
+ * byte of each, unless consume is false.
+ */
+struct FDRecorder
+	: public base::RunnableInterface
+{
+	std::vector< std::vector<int> > steps;
+	bool consume;
+
+	FDRecorder() : consume(true) {}
+	bool initialize() { return true; }
+	void step()
+	{
+		extras::FileDescriptorActivity* fd_activity =
+			dynamic_cast<extras::FileDescriptorActivity*>(getActivity());
+		assert(0 != fd_activity);
+		if (fd_activity->hasTimeout() || fd_activity->hasError())
+			return;
+		const std::vector<int>& fds = fd_activity->getUpdatedFDs();
+		steps.push_back(fds);
+		for (unsigned int i = 0; consume && i != fds.size(); ++i)
+		{
+			BOOST_CHECK( fd_activity->isUpdated(fds[i]) );
+			char ch;
+			int rc = read(fds[i], &ch, sizeof(ch));
+			(void)rc;
+		}
+	}
+	void finalize() {}
+};
+
+/**
+ * Once, makes a file descriptor ready and watches another one
+ * from within step(), such that both are seen in the same iteration.
+ */
+struct FDRewatcher
+	: public FDRecorder
+{
+	int ready_fd;
+	int watch_fd;
+
+	FDRewatcher() : ready_fd(-1), watch_fd(-1) {}
+	void step()
+	{
+		FDRecorder::step();
+		if (ready_fd == -1)
+			return;
+		char ch = 'a';
+		BOOST_CHECK_EQUAL( 1, write(ready_fd, &ch, sizeof(ch)) );
+		dynamic_cast<extras::FileDescriptorActivity*>(getActivity())->watch(watch_fd);
+		ready_fd = -1;
+	}
+};
+
 // Registers the fixture into the 'registry'
 BOOST_FIXTURE_TEST_SUITE( ActivitiesThreadTestSuite, ActivitiesThreadTest )
 
@@ -283,5 +338,146 @@ BOOST_AUTO_TEST_CASE(testFileDescriptor_Timeout )
     BOOST_CHECK_LE( 0, mcomp.countUpdate );
 }
 
+BOOST_AUTO_TEST_CASE(testFileDescriptor_Epoll )
+{
+	TestFileDescriptor		mcomp("Comp");
+	mcomp.setActivity( new FileDescriptorActivity( FileDescriptorActivity::Epoll, ORO_SCHED_RT, 15 ) );
+	FileDescriptorActivity* mtask = dynamic_cast<FileDescriptorActivity*>( mcomp.getActivity() );
+#ifdef OS_HAVE_EPOLL
+	BOOST_CHECK_EQUAL( FileDescriptorActivity::Epoll, mtask->getBackend() );
+#endif
+	char					ch='a';
+
+	BOOST_CHECK( mcomp.configure() == true );
+	BOOST_CHECK( mtask->isWatched(mcomp.fd[0]) == true );
+	BOOST_CHECK( mcomp.start() == true );
+	usleep(1000000/10);
+	BOOST_CHECK_EQUAL( 0, mcomp.countRead );
+
+	BOOST_CHECK_EQUAL( 1, write(mcomp.fd[1], &ch, sizeof(ch)) );
+	usleep(1000000/10);
+	BOOST_CHECK_EQUAL( 0, mcomp.countError );
+	BOOST_CHECK_EQUAL( 1, mcomp.countRead );
+
+	mtask->unwatch(mcomp.fd[0]);
+	BOOST_CHECK( mtask->isWatched(mcomp.fd[0]) == false );
+	BOOST_CHECK_EQUAL( 1, write(mcomp.fd[1], &ch, sizeof(ch)) );
+	usleep(1000000/10);
+	BOOST_CHECK_EQUAL( 1, mcomp.countRead );	// no change
+
+	BOOST_CHECK( mtask->stop() == true );
+}
+
+BOOST_AUTO_TEST_CASE(testFileDescriptor_Updated )
+{
+	static const int	PIPES = 8;
+	int					fds[PIPES][2];
+	char				ch = 'a';
+	FDRecorder			recorder;
+	FileDescriptorActivity::Backend backends[] = { FileDescriptorActivity::Select, FileDescriptorActivity::Epoll };
+
+	for (int b = 0; b != 2; ++b)
+	{
+		FileDescriptorActivity mtask( backends[b], ORO_SCHED_RT, 15, &recorder );
+		recorder.steps.clear();
+		for (int i = 0; i != PIPES; ++i)
+		{
+			BOOST_REQUIRE_EQUAL( 0, pipe(fds[i]) );
+			mtask.watch(fds[i][0]);
+			BOOST_CHECK_EQUAL( 1, write(fds[i][1], &ch, sizeof(ch)) );
+		}
+
+		// all ready file descriptors are reported in one step.
+		BOOST_CHECK( mtask.start() );
+		usleep(1000000/10);
+		BOOST_REQUIRE_EQUAL( 1u, recorder.steps.size() );
+		BOOST_REQUIRE_EQUAL( size_t(PIPES), recorder.steps[0].size() );
+		for (int i = 0; i != PIPES; ++i)
+			BOOST_CHECK_EQUAL( fds[i][0], recorder.steps[0][i] );
+
+		// one-shot watches report once, until watched again.
+		mtask.watch(fds[0][0], FileDescriptorActivity::OneShot);
+		usleep(1000000/10);
+		recorder.steps.clear();
+		BOOST_CHECK_EQUAL( 1, write(fds[0][1], &ch, sizeof(ch)) );
+		BOOST_CHECK_EQUAL( 1, write(fds[0][1], &ch, sizeof(ch)) );
+		usleep(1000000/10);
+		BOOST_CHECK_EQUAL( 1u, recorder.steps.size() );
+		mtask.watch(fds[0][0], FileDescriptorActivity::OneShot);
+		usleep(1000000/10);
+		BOOST_CHECK_EQUAL( 2u, recorder.steps.size() );
+
+		BOOST_CHECK( mtask.stop() );
+		for (int i = 0; i != PIPES; ++i)
+		{
+			close(fds[i][0]);
+			close(fds[i][1]);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(testFileDescriptor_OneShotUpdate )
+{
+	int					a[2], b[2];
+	char				ch = 'a';
+	FileDescriptorActivity::Backend backends[] = { FileDescriptorActivity::Select, FileDescriptorActivity::Epoll };
+
+	for (int i = 0; i != 2; ++i)
+	{
+		FDRewatcher			rewatcher;
+		FileDescriptorActivity mtask( backends[i], ORO_SCHED_RT, 15, &rewatcher );
+		BOOST_REQUIRE_EQUAL( 0, pipe(a) );
+		BOOST_REQUIRE_EQUAL( 0, pipe(b) );
+		mtask.watch(a[0], FileDescriptorActivity::OneShot);
+		mtask.watch(b[0]);
+		BOOST_CHECK( mtask.start() );
+		usleep(1000000/10);
+		rewatcher.steps.clear();
+
+		// a one-shot event which coincides with a watch() is still reported.
+		rewatcher.ready_fd = a[1];
+		rewatcher.watch_fd = b[0];
+		BOOST_CHECK_EQUAL( 1, write(b[1], &ch, sizeof(ch)) );
+		usleep(1000000/10);
+		BOOST_REQUIRE_EQUAL( 2u, rewatcher.steps.size() );
+		BOOST_REQUIRE_EQUAL( 1u, rewatcher.steps[1].size() );
+		BOOST_CHECK_EQUAL( a[0], rewatcher.steps[1][0] );
+
+		BOOST_CHECK( mtask.stop() );
+		close(a[0]); close(a[1]);
+		close(b[0]); close(b[1]);
+	}
+}
+
+#ifdef OS_HAVE_EPOLL
+BOOST_AUTO_TEST_CASE(testFileDescriptor_EdgeTriggered )
+{
+	int					fd[2];
+	char				ch = 'a';
+	FDRecorder			recorder;
+	FileDescriptorActivity mtask( FileDescriptorActivity::Epoll, ORO_SCHED_RT, 15, &recorder );
+
+	// data which is not read is only reported once.
+	recorder.consume = false;
+	BOOST_REQUIRE_EQUAL( 0, pipe(fd) );
+	mtask.watch(fd[0], FileDescriptorActivity::EdgeTriggered);
+	BOOST_CHECK( mtask.start() );
+	usleep(1000000/10);
+	recorder.steps.clear();
+	BOOST_CHECK_EQUAL( 1, write(fd[1], &ch, sizeof(ch)) );
+	usleep(1000000/10);
+	BOOST_CHECK_EQUAL( 1u, recorder.steps.size() );
+
+	// new data is reported again.
+	BOOST_CHECK_EQUAL( 1, write(fd[1], &ch, sizeof(ch)) );
+	usleep(1000000/10);
+	BOOST_CHECK_EQUAL( 2u, recorder.steps.size() );
+
+	BOOST_CHECK( mtask.stop() );
+	close(fd[0]);
+	close(fd[1]);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -27,6 +27,7 @@
 #include <extras/TimerThread.hpp>
 #include <extras/SimulationThread.hpp>
 #include <os/MainThread.hpp>
+#include <os/Event.hpp>
 #include <Logger.hpp>
 #include <rtt-config.h>
 
@@ -258,6 +259,63 @@ BOOST_AUTO_TEST_CASE( testNonPeriodic )
     }
 }
 
+/**
+ * Waits on an event in loop().
+ */
+struct EventWaiter
+    : public RunnableInterface
+{
+    os::Event event;
+    bool woken;
+    int loops;
+    EventWaiter() : woken(false), loops(0) {}
+    bool initialize() { return true; }
+    void step() {}
+    void loop() {
+        ++loops;
+        if ( woken )
+            return;
+        event.wait();
+        woken = true;
+    }
+    void finalize() {}
+};
+
+BOOST_AUTO_TEST_CASE( testEvent )
+{
+    os::Event ev;
+    BOOST_CHECK( ev.isSet() == false );
+    BOOST_CHECK( ev.trywait() == false );
+    // nobody sleeps: nothing to wake up, and signals merge.
+    BOOST_CHECK( ev.signal() == false );
+    BOOST_CHECK( ev.signal() == false );
+    BOOST_CHECK( ev.isSet() );
+    BOOST_CHECK( ev.trywait() );
+    BOOST_CHECK( ev.trywait() == false );
+    ev.signal();
+    ev.wait();
+    BOOST_CHECK( ev.isSet() == false );
+
+    // wake up a sleeping thread.
+    EventWaiter waiter;
+    Activity act(ORO_SCHED_OTHER, 0, 0.0, &waiter, "EventWaiter");
+    BOOST_CHECK( act.start() );
+    usleep(100000);
+    BOOST_CHECK( waiter.woken == false );
+    BOOST_CHECK( waiter.event.signal() );
+    usleep(100000);
+    BOOST_CHECK( waiter.woken );
+
+    // triggers of a busy or idle thread merge into at most one more loop().
+    int loops = waiter.loops;
+    for (int i = 0; i != 1000; ++i)
+        BOOST_CHECK( act.trigger() );
+    usleep(100000);
+    BOOST_CHECK( waiter.loops > loops );
+    BOOST_CHECK( waiter.loops <= loops + 1000 );
+    BOOST_CHECK( act.stop() );
+}
+
 BOOST_AUTO_TEST_CASE( testSlave )
 {
     // Test slave activities
@@ -116,4 +116,4 @@ public:
 
 };
 
-BOOST_GLOBAL_FIXTURE( InitOrocos )
+BOOST_GLOBAL_FIXTURE( InitOrocos );
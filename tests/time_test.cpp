@@ -297,6 +297,37 @@ BOOST_AUTO_TEST_CASE( testTimerPeriod )
     BOOST_CHECK( timer.occured.size() == 0 );
 }
 
+BOOST_AUTO_TEST_CASE( testManyTimers )
+{
+    TestTimer timer;
+    const int max = 10000;
+    timer.setMaxTimers( max );
+    timer.occured.reserve( max );
+
+    // arm all timers in a scrambled order of expiry and kill the odd ones.
+    for (int i = 0; i != max; ++i)
+        BOOST_CHECK( timer.arm(i, 0.5 + (i * 7919 % max) * 0.00001) );
+    for (int i = 1; i < max; i += 2)
+        BOOST_CHECK( timer.killTimer(i) );
+    BOOST_CHECK( timer.isArmed( 0 ) );
+    BOOST_CHECK( !timer.isArmed( 1 ) );
+
+    sleep(2);
+
+    BOOST_REQUIRE_EQUAL( timer.occured.size(), size_t(max / 2) );
+    std::vector<bool> fired( max, false );
+    for (unsigned int i = 0; i != timer.occured.size(); ++i) {
+        Timer::TimerId id = timer.occured[i].first;
+        BOOST_CHECK( id % 2 == 0 );
+        BOOST_CHECK( !fired[id] );
+        fired[id] = true;
+        if ( i > 0 )
+            BOOST_CHECK( timer.occured[i-1].second <= timer.occured[i].second );
+    }
+    for (int i = 0; i != max; ++i)
+        BOOST_CHECK( !timer.isArmed(i) );
+}
+
 BOOST_AUTO_TEST_CASE( testTimerWaitFor )
 {
     TestTimer timer;